@@ -38,10 +38,13 @@
 #include "ns3/node.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
 #include "ns3/object-factory.h"
 #include "HE-wifi-channel.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/propagation-delay-model.h"
+#include <algorithm>
+#include <cmath>
 
 namespace ns3 {
 
@@ -64,11 +67,27 @@ HEWifiChannel::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&HEWifiChannel::m_delay),
                    MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("RxPowerFloor",
+                   "Receivers for which the propagation loss model returns an rx power (dBm) below "
+                   "this value are not scheduled at all. Such signals are neither received nor "
+                   "accounted as interference, so this should stay well below the CCA and "
+                   "sensitivity thresholds. The default value propagates every signal.",
+                   DoubleValue (-1.0e9),
+                   MakeDoubleAccessor (&HEWifiChannel::m_rxPowerFloorDbm),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("CullingRange",
+                   "Distance (m) beyond which the rx power is assumed to be below RxPowerFloor. "
+                   "When non zero, receivers are bucketed in a grid of this cell size and only "
+                   "the cells surrounding the sender are considered. Zero disables spatial culling.",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&HEWifiChannel::m_cullingRange),
+                   MakeDoubleChecker<double> (0.0))
   ;
   return tid;
 }
 
 HEWifiChannel::HEWifiChannel ()
+  : m_indexDirty (true)
 {
 }
 
@@ -76,6 +95,8 @@ HEWifiChannel::~HEWifiChannel ()
 {
   NS_LOG_FUNCTION_NOARGS ();
   m_phyList.clear ();
+  m_channelIndex.clear ();
+  m_mobilityList.clear ();
 }
 
 void
@@ -96,47 +117,132 @@ HEWifiChannel::Send (Ptr<HEWifiPhy> sender, Ptr<const Packet> packet, double txP
 {
   Ptr<MobilityModel> senderMobility = sender->GetMobility ()->GetObject<MobilityModel> ();
   NS_ASSERT (senderMobility != 0);
-  uint32_t j = 0;
-  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++, j++)
+  if (m_indexDirty)
     {
-      if (sender != (*i))
+      RebuildIndex ();
+    }
+
+  //For now don't account for inter channel interference
+  ChannelIndexMap::const_iterator channel = m_channelIndex.find (sender->GetChannelNumber ());
+  if (channel == m_channelIndex.end ())
+    {
+      return;
+    }
+
+  const PhyIndexList *receivers = &channel->second.phys;
+  if (m_cullingRange > 0)
+    {
+      std::pair<int32_t, int32_t> cell = GetCell (senderMobility->GetPosition ());
+      m_candidates.clear ();
+      for (int32_t dx = -1; dx <= 1; dx++)
         {
-          //For now don't account for inter channel interference
-          if ((*i)->GetChannelNumber () != sender->GetChannelNumber ())
+          for (int32_t dy = -1; dy <= 1; dy++)
             {
-              continue;
+              PhyGrid::const_iterator it = channel->second.grid.find (std::make_pair (cell.first + dx, cell.second + dy));
+              if (it != channel->second.grid.end ())
+                {
+                  m_candidates.insert (m_candidates.end (), it->second.begin (), it->second.end ());
+                }
             }
+        }
+      //Keep the PHY list order so that simultaneous receptions are scheduled as without culling
+      std::sort (m_candidates.begin (), m_candidates.end ());
+      receivers = &m_candidates;
+    }
+
+  for (PhyIndexList::const_iterator i = receivers->begin (); i != receivers->end (); i++)
+    {
+      uint32_t j = *i;
+      if (sender == m_phyList[j])
+        {
+          continue;
+        }
+
+      Ptr<MobilityModel> receiverMobility = m_mobilityList[j];
+      double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility, txVector.GetRu(), m_phyList[j]->GetChannelNumber());
+      if (rxPowerDbm < m_rxPowerFloorDbm)
+        {
+          NS_LOG_LOGIC ("culled receiver " << j << ": rxPower=" << rxPowerDbm << "dbm");
+          continue;
+        }
+      Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
+      NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
+                    "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
+      Ptr<Packet> copy = packet->Copy ();
+
+      struct HeParameters parameters;
+      parameters.rxPowerDbm = rxPowerDbm;
+      parameters.type = mpdutype;
+      parameters.duration = duration;
+      parameters.txVector = txVector;
+      parameters.preamble = preamble;
 
-          Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
-          Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
- 
-          double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility, txVector.GetRu(), (*i)->GetChannelNumber());
-          NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
-                        "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
-          Ptr<Packet> copy = packet->Copy ();
-          Ptr<Object> dstNetDevice = m_phyList[j]->GetDevice ();
-          uint32_t dstNode;
-          if (dstNetDevice == 0)
+      Simulator::ScheduleWithContext (m_nodeIdList[j],
+                                      delay, &HEWifiChannel::Receive, this,
+                                      j, copy, parameters);
+    }
+}
+
+void
+HEWifiChannel::RebuildIndex (void) const
+{
+  NS_LOG_FUNCTION (this);
+  m_channelIndex.clear ();
+  for (uint32_t j = 0; j < m_phyList.size (); j++)
+    {
+      if (m_mobilityList[j] == 0)
+        {
+          Ptr<Object> mobility = m_phyList[j]->GetMobility ();
+          if (mobility != 0)
             {
-              dstNode = 0xffffffff;
+              m_mobilityList[j] = mobility->GetObject<MobilityModel> ();
             }
-          else
+          if (m_mobilityList[j] != 0)
             {
-              dstNode = dstNetDevice->GetObject<NetDevice> ()->GetNode ()->GetId ();
+              m_mobilityList[j]->TraceConnectWithoutContext ("CourseChange", MakeCallback (&HEWifiChannel::NotifyCourseChange, this));
             }
+        }
+      Ptr<Object> dstNetDevice = m_phyList[j]->GetDevice ();
+      if (dstNetDevice == 0)
+        {
+          m_nodeIdList[j] = 0xffffffff;
+        }
+      else
+        {
+          m_nodeIdList[j] = dstNetDevice->GetObject<NetDevice> ()->GetNode ()->GetId ();
+        }
 
-          struct HeParameters parameters;
-          parameters.rxPowerDbm = rxPowerDbm;
-          parameters.type = mpdutype;
-          parameters.duration = duration;
-          parameters.txVector = txVector;
-          parameters.preamble = preamble;
-
-          Simulator::ScheduleWithContext (dstNode,
-                                          delay, &HEWifiChannel::Receive, this,
-                                          j, copy, parameters);
+      ChannelIndex &channel = m_channelIndex[m_phyList[j]->GetChannelNumber ()];
+      channel.phys.push_back (j);
+      if (m_cullingRange > 0)
+        {
+          NS_ASSERT_MSG (m_mobilityList[j] != 0, "Spatial culling requires a mobility model on every PHY");
+          channel.grid[GetCell (m_mobilityList[j]->GetPosition ())].push_back (j);
         }
     }
+  m_indexDirty = false;
+}
+
+std::pair<int32_t, int32_t>
+HEWifiChannel::GetCell (const Vector &position) const
+{
+  return std::make_pair (static_cast<int32_t> (std::floor (position.x / m_cullingRange)),
+                         static_cast<int32_t> (std::floor (position.y / m_cullingRange)));
+}
+
+void
+HEWifiChannel::NotifyCourseChange (Ptr<const MobilityModel> mobility) const
+{
+  if (m_cullingRange > 0)
+    {
+      m_indexDirty = true;
+    }
+}
+
+void
+HEWifiChannel::NotifyChannelSwitch (void)
+{
+  m_indexDirty = true;
 }
 
 void
@@ -161,6 +267,9 @@ void
 HEWifiChannel::Add (Ptr<HEWifiPhy> phy)
 {
   m_phyList.push_back (phy);
+  m_mobilityList.push_back (0);
+  m_nodeIdList.push_back (0xffffffff);
+  m_indexDirty = true;
 }
 
 int64_t
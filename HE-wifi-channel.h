@@ -35,6 +35,7 @@
 #define HE_WIFI_CHANNEL_H
 
 #include <vector>
+#include <map>
 #include <stdint.h>
 #include "ns3/packet.h"
 #include "wifi-channel.h"
@@ -43,10 +44,12 @@
 #include "wifi-tx-vector.h"
 #include "HE-wifi-phy.h"
 #include "ns3/nstime.h"
+#include "ns3/vector.h"
 
 namespace ns3 {
 
 class NetDevice;
+class MobilityModel;
 class PropagationLossModel;
 class PropagationDelayModel;
 
@@ -112,6 +115,11 @@ public:
    * currently invoked only from WifiPhy::Send. HEWifiChannel
    * delivers packets only between PHYs with the same m_channelNumber,
    * e.g. PHYs that are operating on the same channel.
+   *
+   * Receivers are looked up through a per-channel-number index. If the
+   * CullingRange attribute is set, only the PHYs located in the grid cells
+   * surrounding the sender are considered, and receivers whose rx power
+   * falls below the RxPowerFloor attribute are not scheduled at all.
    */
   void Send (Ptr<HEWifiPhy> sender, Ptr<const Packet> packet, double txPowerDbm,
              WifiTxVector txVector, WifiPreamble preamble, enum mpduType mpdutype, Time duration) const;
@@ -126,12 +134,52 @@ public:
    */
   int64_t AssignStreams (int64_t stream);
 
+  /**
+   * Invalidate the receiver index. Must be called whenever an attached
+   * HEWifiPhy changes its channel number; the index is rebuilt on the
+   * next call to Send.
+   */
+  void NotifyChannelSwitch (void);
+
 
 private:
   /**
    * A vector of pointers to HEWifiPhy.
    */
   typedef std::vector<Ptr<HEWifiPhy> > PhyList;
+  /**
+   * A list of indexes into the PHY list.
+   */
+  typedef std::vector<uint32_t> PhyIndexList;
+  /**
+   * The PHYs of one channel number, bucketed by (x, y) grid cell of
+   * CullingRange meters.
+   */
+  typedef std::map<std::pair<int32_t, int32_t>, PhyIndexList> PhyGrid;
+
+  struct ChannelIndex
+  {
+    PhyIndexList phys;                 //!< all PHYs operating on the channel number
+    PhyGrid grid;                      //!< same PHYs, bucketed by position (CullingRange > 0 only)
+  };
+  typedef std::map<uint16_t, ChannelIndex> ChannelIndexMap;
+
+  /**
+   * Rebuild the per-channel-number receiver index, cache the mobility
+   * model and node id of every PHY and hook their CourseChange traces.
+   */
+  void RebuildIndex (void) const;
+  /**
+   * \param position the position to locate
+   * \return the grid cell holding the given position
+   */
+  std::pair<int32_t, int32_t> GetCell (const Vector &position) const;
+  /**
+   * Mark the grid stale when a PHY moves.
+   *
+   * \param mobility the mobility model that changed course
+   */
+  void NotifyCourseChange (Ptr<const MobilityModel> mobility) const;
 
   /**
    * This method is scheduled by Send for each associated HEWifiPhy.
@@ -149,6 +197,14 @@ private:
   PhyList m_phyList;                   //!< List of HEWifiPhys connected to this HEWifiChannel
   Ptr<PropagationLossModel> m_loss;    //!< Propagation loss model
   Ptr<PropagationDelayModel> m_delay;  //!< Propagation delay model
+  double m_rxPowerFloorDbm;            //!< Receivers below this rx power are not scheduled
+  double m_cullingRange;               //!< Grid cell size in meters, 0 disables spatial culling
+
+  mutable bool m_indexDirty;                               //!< Whether the receiver index must be rebuilt
+  mutable ChannelIndexMap m_channelIndex;                  //!< PHYs bucketed by channel number
+  mutable std::vector<Ptr<MobilityModel> > m_mobilityList; //!< Cached mobility model of each PHY
+  mutable std::vector<uint32_t> m_nodeIdList;              //!< Cached context (node id) of each PHY
+  mutable PhyIndexList m_candidates;                       //!< Scratch list reused by Send
 };
 
 } //namespace ns3
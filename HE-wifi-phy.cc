@@ -88,6 +88,10 @@ HEWifiPhy::DoChannelSwitch (uint16_t nch)
     {
       //this is not channel switch, this is initialization
       NS_LOG_DEBUG ("initialize to channel " << nch);
+      if (m_channel != 0)
+        {
+          m_channel->NotifyChannelSwitch ();
+        }
       return true;
     }
 
@@ -123,6 +127,8 @@ switchChannel:
   NS_LOG_DEBUG ("switching channel " << GetChannelNumber () << " -> " << nch);
   m_state->SwitchToChannelSwitching (GetChannelSwitchDelay ());
   m_interference.EraseEvents ();
+  m_ruInterference.EraseEvents ();
+  m_channel->NotifyChannelSwitch ();
   /*
    * Needed here to be able to correctly sensed the medium for the first
    * time after the switching. The actual switching is not performed until
@@ -140,6 +146,10 @@ HEWifiPhy::DoFrequencySwitch (uint32_t frequency)
     {
       //this is not channel switch, this is initialization
       NS_LOG_DEBUG ("start at frequency " << frequency);
+      if (m_channel != 0)
+        {
+          m_channel->NotifyChannelSwitch ();
+        }
       return true;
     }
 
@@ -175,6 +185,8 @@ switchFrequency:
   NS_LOG_DEBUG ("switching frequency " << GetFrequency () << " -> " << frequency);
   m_state->SwitchToChannelSwitching (GetChannelSwitchDelay ());
   m_interference.EraseEvents ();
+  m_ruInterference.EraseEvents ();
+  m_channel->NotifyChannelSwitch ();
   /*
    * Needed here to be able to correctly sensed the medium for the first
    * time after the switching. The actual switching is not performed until
@@ -298,6 +310,11 @@ HEWifiPhy::StartReceivePreambleAndHeader (Ptr<Packet> packet,
                               preamble,
                               rxDuration,
                               rxPowerW);
+  // The error rate model and noise figure are the WifiPhy ones, the
+  // payload of the signals on the air is integrated from here on
+  m_ruInterference.SetErrorRateModel (GetErrorRateModel ());
+  m_ruInterference.SetNoiseFigure (DbToRatio (GetRxNoiseFigure ()));
+  m_ruInterference.Add (event, GetChannelWidth ());
   if ((GetColor() != 0 && txVector.GetColor() !=0) && txVector.GetColor() != GetColor())
     {
       NS_LOG_DEBUG ("station dropped packet received on different BSS");
@@ -616,11 +633,11 @@ HEWifiPhy::EndReceive (Ptr<Packet> packet, enum WifiPreamble preamble, enum mpdu
   NS_LOG_FUNCTION (this << packet << event);
   NS_ASSERT (IsStateRx ());
   NS_ASSERT (event->GetEndTime () == Simulator::Now ());
-  Ptr<UniformRandomVariable> urv = CreateObject<UniformRandomVariable> ();
 
   struct InterferenceHelper::SnrPer snrPer;
 
-  snrPer = m_interference.CalculatePlcpPayloadSnrPer (event);
+  // Only the signals overlapping the RU of the packet interfere with it
+  snrPer = m_ruInterference.CalculatePlcpPayloadSnrPer (event);
   if (packet->GetSize() < 150){
     snrPer.per = 0;
   }
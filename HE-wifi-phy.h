@@ -36,6 +36,7 @@
 #define HE_WIFI_PHY_H
 
 #include "wifi-phy.h"
+#include "he-ru-interference-helper.h"
 
 namespace ns3 {
 
@@ -130,6 +131,7 @@ private:
   void EndReceive (Ptr<Packet> packet, enum WifiPreamble preamble, enum mpduType mpdutype, Ptr<InterferenceHelper::Event> event);
 
   Ptr<HEWifiChannel> m_channel;        //!< HEWifiChannel that this HEWifiPhy is connected to
+  HeRuInterferenceHelper m_ruInterference; //!< Interference on each RU, for the SNR and PER of receptions
 };
 
 } //namespace ns3
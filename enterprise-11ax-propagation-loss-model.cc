@@ -84,12 +84,20 @@ Enterprise11axPropagationLossModel::GetTypeId (void)
                    "Channel Number",
                    IntegerValue (1),
                    MakeIntegerAccessor (&Enterprise11axPropagationLossModel::m_channelNumber),
-                   MakeIntegerChecker<int> ());
+                   MakeIntegerChecker<int> ())
+    .AddAttribute ("CacheLinkLoss",
+                   "Compute the loss of each (tx, rx, RU frequency) link only once "
+                   "and reuse it until either end reports a course change. "
+                   "Intended for static topologies.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&Enterprise11axPropagationLossModel::m_cacheLinkLoss),
+                   MakeBooleanChecker ());
   return tid;
 }
 
 Enterprise11axPropagationLossModel::Enterprise11axPropagationLossModel ()
-  : PropagationLossModel ()
+  : PropagationLossModel (),
+    m_cacheLinkLoss (false)
 {
   NS_LOG_DEBUG ("In Enterprise model");
 }
@@ -100,6 +108,54 @@ Enterprise11axPropagationLossModel::~Enterprise11axPropagationLossModel ()
 
 double
 Enterprise11axPropagationLossModel::GetLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+{
+  if (!m_cacheLinkLoss)
+    {
+      return CalcLoss (a, b);
+    }
+
+  LinkKey key = {PeekPointer (a), PeekPointer (b), m_frequency};
+  LinkLossCache::const_iterator it = m_linkLossCache.find (key);
+  if (it != m_linkLossCache.end ())
+    {
+      return it->second;
+    }
+  TrackMobility (a);
+  TrackMobility (b);
+  double loss = CalcLoss (a, b);
+  m_linkLossCache.insert (std::make_pair (key, loss));
+  return loss;
+}
+
+void
+Enterprise11axPropagationLossModel::TrackMobility (Ptr<MobilityModel> mobility) const
+{
+  if (m_tracked.insert (mobility).second)
+    {
+      mobility->TraceConnectWithoutContext ("CourseChange", MakeCallback (&Enterprise11axPropagationLossModel::NotifyCourseChange, this));
+    }
+}
+
+void
+Enterprise11axPropagationLossModel::NotifyCourseChange (Ptr<const MobilityModel> mobility) const
+{
+  NS_LOG_FUNCTION (this << mobility);
+  const MobilityModel *moved = PeekPointer (mobility);
+  for (LinkLossCache::iterator it = m_linkLossCache.begin (); it != m_linkLossCache.end (); )
+    {
+      if (it->first.a == moved || it->first.b == moved)
+        {
+          m_linkLossCache.erase (it++);
+        }
+      else
+        {
+          ++it;
+        }
+    }
+}
+
+double
+Enterprise11axPropagationLossModel::CalcLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
 {
   double loss = 0.0;
   double fGhz = m_frequency / 1e9;
@@ -168,15 +224,7 @@ Enterprise11axPropagationLossModel::SetChannelNumber(int ChannelNumber)
 double
 Enterprise11axPropagationLossModel::CalculateFcFromBitMap(void)
 {
-  double fc = 0.0;
-  HEBitMap BitMap;
-  double offset = 0.0;
-  fc = BitMap.GetCentralFrequencyFromChannelNumber(m_channelNumber);
-  RUInfo RU = {0};
-  RU = BitMap.GetRUInfoFromTriggerBitMap(m_bitMap);
-  offset = BitMap.GetRUOffset(RU.type, RU.index, m_channelNumber);
-  fc = fc + offset;
-  return fc;
+  return HEBitMap::GetRUCenterFrequency(m_channelNumber, m_bitMap);
 }
 
 } // namespace ns3
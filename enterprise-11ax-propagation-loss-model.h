@@ -32,6 +32,8 @@
 #define ENTERPRISE_11AX_PROPAGATION_LOSS_MODEL_H
 
 #include <ns3/propagation-loss-model.h>
+#include <map>
+#include <set>
 
 namespace ns3 {
 
@@ -54,6 +56,50 @@ private:
   Enterprise11axPropagationLossModel (const Enterprise11axPropagationLossModel &);
   Enterprise11axPropagationLossModel & operator = (const Enterprise11axPropagationLossModel &);
 
+  /**
+   * A (tx mobility, rx mobility, RU center frequency) link.
+   */
+  struct LinkKey
+  {
+    const MobilityModel *a;
+    const MobilityModel *b;
+    double frequency;
+
+    bool operator < (const LinkKey &o) const
+    {
+      if (a != o.a)
+        {
+          return a < o.a;
+        }
+      if (b != o.b)
+        {
+          return b < o.b;
+        }
+      return frequency < o.frequency;
+    }
+  };
+  typedef std::map<LinkKey, double> LinkLossCache;
+
+  /**
+   * \param a the mobility model of the source
+   * \param b the mobility model of the destination
+   * \return the loss in dB at the current m_frequency, uncached
+   */
+  double CalcLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+  /**
+   * Hook the CourseChange trace of the given mobility model the first
+   * time it is seen, so that its cached links can be dropped when it moves.
+   *
+   * \param mobility the mobility model to track
+   */
+  void TrackMobility (Ptr<MobilityModel> mobility) const;
+  /**
+   * Drop every cached link involving the mobility model that moved.
+   *
+   * \param mobility the mobility model that changed course
+   */
+  void NotifyCourseChange (Ptr<const MobilityModel> mobility) const;
+
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
@@ -63,7 +109,6 @@ private:
                                 int BitMap, int ChannelNumber);
   virtual int64_t DoAssignStreams (int64_t stream);
 
-  HEBitMap BitMap;
   double m_frequency;
   double m_baseFreq;
   double m_indoorWallLoss;
@@ -71,6 +116,9 @@ private:
   double m_shadowingStandardDeviation;
   int m_bitMap;
   int m_channelNumber;
+  bool m_cacheLinkLoss;                                   //!< Cache the loss of each link per RU frequency
+  mutable LinkLossCache m_linkLossCache;                  //!< Cached link losses in dB
+  mutable std::set<Ptr<const MobilityModel> > m_tracked;  //!< Mobility models whose CourseChange is hooked
 };
 
 } // namespace ns3
@@ -44,12 +44,405 @@
 
 #define LOWER_FREQ_2_4GHZ 2401
 
+/* Channels known to GetCentralFrequencyFromChannelNumber */
+#define RU_FC_TABLE_CHANNELS 48
+#define RU_FC_TABLE_BITMAPS 256
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("HEBitMap");
 
 NS_OBJECT_ENSURE_REGISTERED (HEBitMap);
 
+namespace {
+
+template <int... I> struct IndexSequence {};
+template <typename A, typename B> struct ConcatIndexSequence;
+template <int... I, int... J>
+struct ConcatIndexSequence<IndexSequence<I...>, IndexSequence<J...> >
+{
+  typedef IndexSequence<I..., (sizeof... (I) + J)...> type;
+};
+/* Logarithmic depth, so that large tables stay within the template depth limit */
+template <int N>
+struct MakeIndexSequence : ConcatIndexSequence<typename MakeIndexSequence<N / 2>::type,
+                                               typename MakeIndexSequence<N - N / 2>::type> {};
+template <> struct MakeIndexSequence<0> { typedef IndexSequence<> type; };
+template <> struct MakeIndexSequence<1> { typedef IndexSequence<0> type; };
+
+/* One cell of the MU PPDU RU distribution table, see HEMuPPDUConstuctTable */
+constexpr unsigned char
+RUDistCell (int row, int column)
+{
+  return row < 16 ? (column == 4 ? 1
+                     : (column == 7 || column == 8) ? row % 2 + 1
+                     : (column == 5 || column == 6) ? (row % 4) / 2 + 1
+                     : (column == 2 || column == 3) ? (row % 8) / 4 + 1
+                     : row / 8 + 1)
+       : (row == 16 || row == 17) ? (column == 4 ? 0
+                                     : column < 4 ? (row == 16 ? 2 : 3)
+                                     : (row == 16 ? 3 : 2))
+       : row < 26 ? (column == 4 ? 1
+                     : ((column < 4 && row - 18 > 3) || (column > 4 && row - 18 < 4)) ? 3
+                     : (column == 2 || column == 3 || column == 7 || column == 8) ? (row - 18) % 2 + 1
+                     : ((row - 18) % 4) / 2 + 1)
+       : (row == 26 || row == 27) ? (column == 4 ? 0 : row == 26 ? 3 : 2)
+       : (row >= 28 && row <= 30) ? 104 + (row - 28)
+       : (row == 31 || row == 32 || row == 38) ? 255
+       : row == 33 ? (column == 4 ? 1 : 3)
+       : 3 + (row - 33);
+}
+
+/* Row of the RU distribution table addressed by an 8 bit MU PPDU bitmap */
+constexpr unsigned char
+IndexFromBitMap (int BitMap)
+{
+  return BitMap < 16 ? BitMap
+       : (BitMap / 8 > 1 && BitMap / 8 < 12) ? 14 + BitMap / 8
+       : BitMap / 16 == 6 ? 26
+       : (BitMap > 111 && BitMap < 116) ? 26 + (BitMap - 111)
+       : BitMap / 4 == 29 ? 31
+       : BitMap / 4 == 31 ? 32
+       : BitMap / 64 == 2 ? 33
+       : (BitMap / 8 > 23 && BitMap / 8 < 28) ? 34 + (BitMap / 8 - 24)
+       : 38;
+}
+
+/* Trigger frame bitmap of an RU of the given type and index */
+constexpr uint8_t
+BitMapFromRUInfo (int type, int index)
+{
+  return type == 1 ? 2 * index
+       : type == 2 ? 2 * (37 + index)
+       : type == 3 ? 2 * (53 + index)
+       : type == 4 ? 2 * (61 + index)
+       : type == 5 ? 2 * (65 + index)
+       : type == 6 ? 2 * (67 + index)
+       : type == 7 ? 137
+       : 0;
+}
+
+#define RU_TYPES 8
+#define RU_MAX_INDEX 37
+
+struct BitMapIndexTable
+{
+  unsigned char index[256];
+};
+
+struct RUBitMapTable
+{
+  uint8_t bitMap[RU_TYPES][RU_MAX_INDEX];
+};
+
+template <int... I>
+constexpr MuPPDUBitMapTable
+MakeRUDistTable (IndexSequence<I...>)
+{
+  return {{ RUDistCell (I / 9, I % 9)... }};
+}
+
+template <int... I>
+constexpr BitMapIndexTable
+MakeBitMapIndexTable (IndexSequence<I...>)
+{
+  return {{ IndexFromBitMap (I)... }};
+}
+
+template <int... I>
+constexpr RUBitMapTable
+MakeRUBitMapTable (IndexSequence<I...>)
+{
+  return {{ BitMapFromRUInfo (I / RU_MAX_INDEX, I % RU_MAX_INDEX)... }};
+}
+
+constexpr MuPPDUBitMapTable g_ruDistTable = MakeRUDistTable (MakeIndexSequence<39 * 9>::type ());
+constexpr BitMapIndexTable g_bitMapIndexTable = MakeBitMapIndexTable (MakeIndexSequence<256>::type ());
+constexpr RUBitMapTable g_ruBitMapTable = MakeRUBitMapTable (MakeIndexSequence<RU_TYPES * RU_MAX_INDEX>::type ());
+
+/* A 20 Mhz row is well formed if 52 tone RUs come in pairs and 106 tone
+ * RUs in fours of the same value, around the center 26 tone RU (column 4) */
+constexpr bool
+RUDistRowIsWellFormed (int row, int column)
+{
+  return column >= 9 ? true
+       : g_ruDistTable.table[row][column] == 0 || g_ruDistTable.table[row][column] == 1
+         ? RUDistRowIsWellFormed (row, column + 1)
+       : g_ruDistTable.table[row][column] == 2
+         ? (column == 0 || column == 2 || column == 5 || column == 7)
+           && g_ruDistTable.table[row][column + 1] == 2
+           && RUDistRowIsWellFormed (row, column + 2)
+       : g_ruDistTable.table[row][column] == 3
+         ? (column == 0 || column == 5)
+           && g_ruDistTable.table[row][column + 1] == 3
+           && g_ruDistTable.table[row][column + 2] == 3
+           && g_ruDistTable.table[row][column + 3] == 3
+           && RUDistRowIsWellFormed (row, column + 4)
+       : false;
+}
+
+constexpr bool
+RUDistRowsAreWellFormed (int row)
+{
+  return row > 33 ? true
+       : (row > 27 && row < 33) ? RUDistRowsAreWellFormed (row + 1)
+       : RUDistRowIsWellFormed (row, 0) && RUDistRowsAreWellFormed (row + 1);
+}
+
+constexpr bool
+BitMapIndexesAreInRange (int BitMap)
+{
+  return BitMap >= 256 ? true
+       : g_bitMapIndexTable.index[BitMap] < 39 && BitMapIndexesAreInRange (BitMap + 1);
+}
+
+static_assert (RUDistRowsAreWellFormed (0), "malformed 20 Mhz row in the RU distribution table");
+static_assert (BitMapIndexesAreInRange (0), "bitmap mapped outside of the RU distribution table");
+static_assert (g_ruDistTable.table[0][0] == 1 && g_ruDistTable.table[15][8] == 2
+               && g_ruDistTable.table[16][4] == 0 && g_ruDistTable.table[33][4] == 1
+               && g_ruDistTable.table[34][0] == 4 && g_ruDistTable.table[37][8] == 7
+               && g_ruDistTable.table[38][0] == 255,
+               "unexpected RU distribution table content");
+static_assert (g_bitMapIndexTable.index[15] == 15 && g_bitMapIndexTable.index[16] == 16
+               && g_bitMapIndexTable.index[95] == 25 && g_bitMapIndexTable.index[96] == 26
+               && g_bitMapIndexTable.index[112] == 27 && g_bitMapIndexTable.index[116] == 31
+               && g_bitMapIndexTable.index[124] == 32 && g_bitMapIndexTable.index[128] == 33
+               && g_bitMapIndexTable.index[192] == 34 && g_bitMapIndexTable.index[216] == 37
+               && g_bitMapIndexTable.index[224] == 38,
+               "unexpected bitmap to RU distribution row mapping");
+static_assert (g_ruBitMapTable.bitMap[1][36] == 72 && g_ruBitMapTable.bitMap[2][0] == 74
+               && g_ruBitMapTable.bitMap[4][3] == 128 && g_ruBitMapTable.bitMap[6][1] == 136
+               && g_ruBitMapTable.bitMap[7][0] == 137 && g_ruBitMapTable.bitMap[0][5] == 0,
+               "unexpected RU info to bitmap mapping");
+
+#define HE_RU_TYPES 7
+#define HE_MAX_MCS 12
+#define HE_GI_COUNT 3
+#define HE_MAX_NSS 8
+
+/* Data subcarriers of RU type 1 (26 tones) to 7 (2x996 tones) */
+constexpr int
+RUDataSubcarriers (int type)
+{
+  return type == 1 ? 24 : type == 2 ? 48 : type == 3 ? 102 : type == 4 ? 234
+       : type == 5 ? 468 : type == 6 ? 980 : 1960;
+}
+
+constexpr int
+McsBitsPerSubcarrier (int mcs)
+{
+  return mcs == 0 ? 1 : mcs < 3 ? 2 : mcs < 5 ? 4 : mcs < 8 ? 6 : mcs < 10 ? 8 : 10;
+}
+
+/* Coding rate of an HE MCS, as numerator / denominator */
+constexpr int
+McsCodingRateNum (int mcs)
+{
+  return (mcs == 0 || mcs == 1 || mcs == 3) ? 1
+       : (mcs == 2 || mcs == 4 || mcs == 6 || mcs == 8 || mcs == 10) ? 3
+       : mcs == 5 ? 2 : 5;
+}
+
+constexpr int
+McsCodingRateDen (int mcs)
+{
+  return (mcs == 0 || mcs == 1 || mcs == 3) ? 2
+       : (mcs == 2 || mcs == 4 || mcs == 6 || mcs == 8 || mcs == 10) ? 4
+       : mcs == 5 ? 3 : 6;
+}
+
+/* HE symbol duration in ns: 12.8 us plus a 0.8, 1.6 or 3.2 us guard interval */
+constexpr double
+HeSymbolDuration (int gi)
+{
+  return gi == 0 ? 13600 : gi == 1 ? 14400 : 16000;
+}
+
+constexpr double
+HeDataRate (int type, int mcs, int gi, int nss)
+{
+  return 1e9 * nss * RUDataSubcarriers (type) * McsBitsPerSubcarrier (mcs) * McsCodingRateNum (mcs)
+         / (McsCodingRateDen (mcs) * HeSymbolDuration (gi));
+}
+
+/* rate[RU type - 1][MCS][GI][NSS - 1] in bit/s */
+struct HeDataRateTable
+{
+  double rate[HE_RU_TYPES][HE_MAX_MCS][HE_GI_COUNT][HE_MAX_NSS];
+};
+
+template <int... I>
+constexpr HeDataRateTable
+MakeHeDataRateTable (IndexSequence<I...>)
+{
+  return {{ HeDataRate (I / (HE_MAX_MCS * HE_GI_COUNT * HE_MAX_NSS) + 1,
+                        (I / (HE_GI_COUNT * HE_MAX_NSS)) % HE_MAX_MCS,
+                        (I / HE_MAX_NSS) % HE_GI_COUNT,
+                        I % HE_MAX_NSS + 1)... }};
+}
+
+constexpr HeDataRateTable g_heDataRateTable =
+  MakeHeDataRateTable (MakeIndexSequence<HE_RU_TYPES * HE_MAX_MCS * HE_GI_COUNT * HE_MAX_NSS>::type ());
+
+static_assert (g_heDataRateTable.rate[0][0][0][0] > 0.88e6 && g_heDataRateTable.rate[0][0][0][0] < 0.89e6,
+               "unexpected rate for 26 tones, MCS 0, 0.8 us GI, 1 stream");
+static_assert (g_heDataRateTable.rate[3][11][2][0] > 121.8e6 && g_heDataRateTable.rate[3][11][2][0] < 121.9e6,
+               "unexpected rate for 242 tones, MCS 11, 3.2 us GI, 1 stream");
+static_assert (g_heDataRateTable.rate[6][11][0][7] > 9.60e9 && g_heDataRateTable.rate[6][11][0][7] < 9.61e9,
+               "unexpected rate for 2x996 tones, MCS 11, 0.8 us GI, 8 streams");
+
+/* RU center frequency by (channel, trigger bitmap). slot[] maps a channel
+ * number to its row in fc[], -1 for channels that are not tabulated. */
+struct RUCenterFrequencyTable
+{
+  int8_t slot[256];
+  double fc[RU_FC_TABLE_CHANNELS][RU_FC_TABLE_BITMAPS];
+};
+
+double
+ComputeRUCenterFrequency (int channelNumber, int TriggerBitMap)
+{
+  RUInfo RU = HEBitMap::GetRUInfoFromTriggerBitMap (TriggerBitMap);
+  return HEBitMap::GetCentralFrequencyFromChannelNumber (channelNumber)
+         + HEBitMap::GetRUOffset (RU.type, RU.index, channelNumber);
+}
+
+void
+BuildRUCenterFrequencyTable (RUCenterFrequencyTable *table)
+{
+  static const uint8_t channels[RU_FC_TABLE_CHANNELS] = {
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+    36, 38, 40, 42, 44, 46, 48, 50, 52, 54, 56, 58, 60, 62, 64,
+    100, 102, 104, 106, 108, 110, 112, 114, 116, 118, 120, 122, 124, 126, 128,
+    132, 134, 136, 138, 140, 142, 144
+  };
+  std::fill (table->slot, table->slot + 256, -1);
+  for (int i = 0; i < RU_FC_TABLE_CHANNELS; i++)
+  {
+    table->slot[channels[i]] = i;
+    for (int bitMap = 0; bitMap < RU_FC_TABLE_BITMAPS; bitMap++)
+      table->fc[i][bitMap] = ComputeRUCenterFrequency (channels[i], bitMap);
+  }
+}
+
+const RUCenterFrequencyTable &
+GetRUCenterFrequencyTable (void)
+{
+  static RUCenterFrequencyTable table;
+  static bool built = false;
+  if (!built)
+  {
+    BuildRUCenterFrequencyTable (&table);
+    built = true;
+  }
+  return table;
+}
+
+/* RUs of every MU PPDU bitmap */
+struct RUDescriptorTable
+{
+  RUDescriptorList list[256];
+};
+
+bool
+CompareRUDescriptorWidth (const RUDescriptor &ru1, const RUDescriptor &ru2)
+{
+  return ru1.channelWidth > ru2.channelWidth;
+}
+
+void
+AddRUDescriptor (RUDescriptorList *ruList, uint8_t bitMap, double fc, double chanWidth)
+{
+  NS_ASSERT (ruList->count < HE_MAX_RU_COUNT);
+  RUDescriptor &ru = ruList->ru[ruList->count++];
+  ru.bitMap = bitMap;
+  ru.mimoUsers = 1;
+  ru.centralFrequency = fc;
+  ru.channelWidth = chanWidth;
+}
+
+void
+BuildRUDescriptorList (RUDescriptorList *ruList, int BitMap)
+{
+  RUInfo ruInfo;
+  double chanWidth = 0.0;
+  int index = 0;
+  bool flag = true;
+  ruList->count = 0;
+
+  /* Single RU covering the whole 40, 80 or 160 Mhz channel */
+  if (BitMap == 200)
+  {
+    AddRUDescriptor(ruList, 130, HEBitMap::GetCentralFrequencyFromChannelNumber(38), 40);
+    return;
+  }
+  else if (BitMap == 208)
+  {
+    AddRUDescriptor(ruList, 134, HEBitMap::GetCentralFrequencyFromChannelNumber(42), 80);
+    return;
+  }
+  else if (BitMap == 216)
+  {
+    AddRUDescriptor(ruList, 137, HEBitMap::GetCentralFrequencyFromChannelNumber(50), 160);
+    return;
+  }
+
+  const unsigned char *ruDist = g_ruDistTable.table[g_bitMapIndexTable.index[BitMap]];
+  for (index = 0;index < 9 && flag;)
+  {
+    ruInfo.type = ruDist[index];
+    if (ruInfo.type == 1){
+      ruInfo.index = index;
+      chanWidth = 2.0;
+      index++;
+    }
+    else if (ruInfo.type == 2){
+      int i = (index > 4) ? ( 2 + (index - 5)/2 ) : ( index/2 );
+      ruInfo.index = i;
+      chanWidth = 4.0;
+      index = index+2;
+    }
+    else if (ruInfo.type == 3){
+      ruInfo.index = (index > 4) ? 1 : 0;
+      chanWidth = 8.0;
+      index = index+4;
+    }
+    else if (ruInfo.type == 4){
+      ruInfo.index = 0;
+      chanWidth = 20.0;
+      index = index+9;
+    }
+    else{
+    index++;
+    flag = false;
+    }
+
+    if(flag){
+      AddRUDescriptor(ruList, g_ruBitMapTable.bitMap[ruInfo.type][ruInfo.index],
+                      HEBitMap::GetCentralFrequencyFromChannelNumber(1)+HEBitMap::GetRUOffset(ruInfo.type, ruInfo.index, 1),
+                      chanWidth);
+    }
+    flag = true;
+  }
+  std::stable_sort(ruList->ru, ruList->ru + ruList->count, CompareRUDescriptorWidth);
+}
+
+const RUDescriptorTable &
+GetRUDescriptorTable (void)
+{
+  static RUDescriptorTable table;
+  static bool built = false;
+  if (!built)
+  {
+    for (int BitMap = 0; BitMap < 256; BitMap++)
+      BuildRUDescriptorList (&table.list[BitMap], BitMap);
+    built = true;
+  }
+  return table;
+}
+
+} // anonymous namespace
+
 TypeId
 HEBitMap::GetTypeId (void)
 {
@@ -73,7 +466,6 @@ HEBitMap::GetTypeId (void)
 HEBitMap::HEBitMap ()
 {
   NS_LOG_FUNCTION (this);
-  HEMuPPDUConstuctTable(&m_RUDistTable);
 }
 
 HEBitMap::~HEBitMap ()
@@ -84,291 +476,42 @@ HEBitMap::~HEBitMap ()
 double
 HEBitMap::GetDataRate(uint32_t mcsVal, uint32_t chanW)
 {
-  double dataRate = 0.0;
-  if (chanW == 2)
-  {
-    switch(mcsVal){
-      case 0:
-        dataRate = 900000;
-        break;
-      case 1:
-        dataRate = 1800000;
-        break;
-      case 2:
-        dataRate = 2600000;
-        break;
-      case 3:
-        dataRate = 3500000;
-        break;
-      case 4:
-        dataRate = 5300000;
-        break;
-      case 5:
-        dataRate = 7100000;
-        break;
-      case 6:
-        dataRate = 7900000;
-        break;
-      case 7:
-        dataRate = 8800000;
-        break;
-      case 8:
-        dataRate = 10600000;
-        break;
-      case 9:
-        dataRate = 11800000;
-        break;
-      default:
-        break;
-    }
-  }
-  else if (chanW == 4)
-  {
-    switch(mcsVal){
-      case 0:
-        dataRate = 1800000;
-        break;
-      case 1:
-        dataRate = 3500000;
-        break;
-      case 2:
-        dataRate = 5300000;
-        break;
-      case 3:
-        dataRate = 7100000;
-        break;
-      case 4:
-        dataRate = 10600000;
-        break;
-      case 5:
-        dataRate = 14100000;
-        break;
-      case 6:
-        dataRate = 15900000;
-        break;
-      case 7:
-        dataRate = 17600000;
-        break;
-      case 8:
-        dataRate = 21200000;
-        break;
-      case 9:
-        dataRate = 23500000;
-        break;
-      default:
-        break;
-    }
-  }
-  else if (chanW == 8)
-  {
-    switch(mcsVal){
-      case 0:
-        dataRate = 3800000;
-        break;
-      case 1:
-        dataRate = 7500000;
-        break;
-      case 2:
-        dataRate = 11300000;
-        break;
-      case 3:
-        dataRate = 15000000;
-        break;
-      case 4:
-        dataRate = 22500000;
-        break;
-      case 5:
-        dataRate = 30000000;
-        break;
-      case 6:
-        dataRate = 33800000;
-        break;
-      case 7:
-        dataRate = 37500000;
-        break;
-      case 8:
-        dataRate = 45000000;
-        break;
-      case 9:
-        dataRate = 50000000;
-        break;
-      default:
-        break;
-    }
-  }
-  else if (chanW == 20)
-  {
-    switch(mcsVal){
-      case 0:
-        dataRate = 8600000;
-        break;
-      case 1:
-        dataRate = 17200000;
-        break;
-      case 2:
-        dataRate = 25800000;
-        break;
-      case 3:
-        dataRate = 34400000;
-        break;
-      case 4:
-        dataRate = 51600000;
-        break;
-      case 5:
-        dataRate = 68800000;
-        break;
-      case 6:
-        dataRate = 77400000;
-        break;
-      case 7:
-        dataRate = 86000000;
-        break;
-      case 8:
-        dataRate = 103200000;
-        break;
-      case 9:
-        dataRate = 114700000;
-        break;
-      case 10:
-        dataRate = 129000000;
-        break;
-      case 11:
-        dataRate = 143400000;
-        break;
-      default:
-        break;
-    }
-  }
-  else if (chanW == 40)
-  {
-    switch(mcsVal){
-      case 0:
-        dataRate = 17200000;
-        break;
-      case 1:
-        dataRate = 34400000;
-        break;
-      case 2:
-        dataRate = 51600000;
-        break;
-      case 3:
-        dataRate = 68800000;
-        break;
-      case 4:
-        dataRate = 103200000;
-        break;
-      case 5:
-        dataRate = 137600000;
-        break;
-      case 6:
-        dataRate = 154900000;
-        break;
-      case 7:
-        dataRate = 172100000;
-        break;
-      case 8:
-        dataRate = 206500000;
-        break;
-      case 9:
-        dataRate = 229400000;
-        break;
-      case 10:
-        dataRate = 258100000;
-        break;
-      case 11:
-        dataRate = 286800000;
-        break;
-      default:
-        break;
-    }
-  }
-  else if (chanW == 80)
+  return GetHeDataRate(GetRUTypeFromChannelWidth(chanW), mcsVal, 800, 1);
+}
+
+double
+HEBitMap::GetHeDataRate(int RUtype, uint32_t mcsVal, uint32_t guardInterval, uint32_t nss)
+{
+  int gi = guardInterval == 800 ? 0 : guardInterval == 1600 ? 1 : guardInterval == 3200 ? 2 : -1;
+  if (RUtype < 1 || RUtype > HE_RU_TYPES || mcsVal >= HE_MAX_MCS || gi < 0 || nss < 1 || nss > HE_MAX_NSS)
   {
-    switch(mcsVal){
-      case 0:
-        dataRate = 36000000;
-        break;
-      case 1:
-        dataRate = 72100000;
-        break;
-      case 2:
-        dataRate = 108100000;
-        break;
-      case 3:
-        dataRate = 144100000;
-        break;
-      case 4:
-        dataRate = 216200000;
-        break;
-      case 5:
-        dataRate = 288200000;
-        break;
-      case 6:
-        dataRate = 324300000;
-        break;
-      case 7:
-        dataRate = 360300000;
-        break;
-      case 8:
-        dataRate = 432400000;
-        break;
-      case 9:
-        dataRate = 480400000;
-        break;
-      case 10:
-        dataRate = 540400000;
-        break;
-      case 11:
-        dataRate = 600400000;
-        break;
-      default:
-        break;
-    }
+    return 0.0;
   }
-  else if (chanW == 160)
+  return g_heDataRateTable.rate[RUtype - 1][mcsVal][gi][nss - 1];
+}
+
+int
+HEBitMap::GetRUTypeFromChannelWidth(uint32_t chanW)
+{
+  switch (chanW)
   {
-    switch(mcsVal){
-      case 0:
-        dataRate = 72100000;
-        break;
-      case 1:
-        dataRate = 144100000;
-        break;
-      case 2:
-        dataRate = 216200000;
-        break;
-      case 3:
-        dataRate = 288200000;
-        break;
-      case 4:
-        dataRate = 432400000;
-        break;
-      case 5:
-        dataRate = 576500000;
-        break;
-      case 6:
-        dataRate = 648500000;
-        break;
-      case 7:
-        dataRate = 720600000;
-        break;
-      case 8:
-        dataRate = 864700000;
-        break;
-      case 9:
-        dataRate = 960700000;
-        break;
-      case 10:
-        dataRate = 1020800000;
-        break;
-      case 11:
-        dataRate = 1134200000;
-        break;
-      default:
-        break;
-    }
+    case 2:
+      return 1;
+    case 4:
+      return 2;
+    case 8:
+      return 3;
+    case 20:
+      return 4;
+    case 40:
+      return 5;
+    case 80:
+      return 6;
+    case 160:
+      return 7;
+    default:
+      return 0;
   }
-  return dataRate;
 }
 
 void HEBitMap::HEMuPPDUConstuctTable(struct MuPPDUBitMapTable *RU)
@@ -385,91 +528,15 @@ void HEBitMap::HEMuPPDUConstuctTable(struct MuPPDUBitMapTable *RU)
     7   - 	RU of 2x996 subcarriers}
 	(i,j = row and column index)
 */
-	
-  unsigned char row=0, column=0;
 
-  for (row = 0; row < 39; row++)
-  {
-    for (column = 0; column < 9; column++)
-    {
-      if (row < 16)
-      {
-        if (column == 4)
-          RU->table[row][column] = 1;
-        else if (column == 7 || column == 8)
-          RU->table[row][column] = (row%2) + 1;
-        else if (column == 5 || column == 6)
-          RU->table[row][column] = floor((row%4)/2) + 1;
-        else if (column == 2 || column == 3)
-          RU->table[row][column] = floor((row%8)/4) + 1;
-        else // column = 0 & 1
-          RU->table[row][column] = floor(row/8) + 1;
-      }
-    else if (row == 16 || row == 17)
-    {
-      if (column == 4)
-        RU->table[row][column] = 0;
-      else if (column < 4)
-        row == 16 ? RU->table[row][column] = 2 : RU->table[row][column] = 3;
-      else // column > 4
-        row == 16 ? RU->table[row][column] = 3 : RU->table[row][column] = 2;
-    }
-    else if (row < 26)
-    {
-      if (column == 4)
-        RU->table[row][column] = 1;
-      else if (((column < 4) && ((row-18) > 3)) || ((column > 4) && ((row-18) < 4)))
-        RU->table[row][column] = 3;
-      else if (column == 2 || column == 3 || column == 7 || column == 8)
-        RU->table[row][column] = (row-18)%2 + 1;
-      else
-        RU->table[row][column] = floor(((row-18)%4)/2) + 1;
-    }
-    else if (row == 26 || row == 27)
-    {
-      if (column == 4)
-        RU->table[row][column] = 0;
-      else
-        row == 26 ? RU->table[row][column] = 3 : RU->table[row][column] = 2;
-    }
-    else if (row == 28 || row == 29 || row == 30)
-      RU->table[row][column] = 104 + (row-28);
-    else if (row == 31 || row == 32 || row == 38)
-      RU->table[row][column] = 255;
-    else if (row == 33)
-    {
-      if (column == 4)
-        RU->table[row][column] = 1;
-      else
-        RU->table[row][column] = 3;
-    }
-    else if (row > 33 && row < 38)
-      RU->table[row][column] = 3 + (row - 33);		
-    }
-  } 
+  *RU = g_ruDistTable;
 }
 
 unsigned char HEBitMap::GetIndexFromBitMap(int BitMap)
 {
-  unsigned char index=0;
-  if (BitMap < 16)
-    index = BitMap;
-  else if (floor(BitMap/8) > 1 && floor(BitMap/8) < 12)
-    index = 14 + floor(BitMap/8);
-  else if (floor(BitMap/16) == 6)
-   index = 26;
-  else if (BitMap > 111 && BitMap < 116)
-    index = 26 + (BitMap - 111);
-  else if (floor(BitMap/4) == 29 || floor(BitMap/4) == 31)
-    (floor(BitMap/4) == 29) ? index = 31 : index =32;
-  else if (floor(BitMap/64) == 2)
-    index = 33;
-  else if (floor(BitMap/8) > 23 && floor(BitMap/8) < 28)
-    index = 34 + (floor(BitMap/8) - 24);
-  else
-    index = 38;
-
-  return index;
+  if (BitMap >= 0 && BitMap < 256)
+    return g_bitMapIndexTable.index[BitMap];
+  return IndexFromBitMap(BitMap);
 }
 
 void HEBitMap::GetRUDistFromBitMap(unsigned char *RUrow, int BitMap)
@@ -478,7 +545,7 @@ void HEBitMap::GetRUDistFromBitMap(unsigned char *RUrow, int BitMap)
   unsigned char i;
   for (i=0; i<9; i++)
   {
-    RUrow[i] = m_RUDistTable.table[index][i];
+    RUrow[i] = g_ruDistTable.table[index][i];
   }
 }
 
@@ -624,27 +691,9 @@ HEBitMap::GetBitMapAll(std::vector<uint32_t> &bitmapPtr)
 }
 
 uint8_t HEBitMap::GetBitMapFromRUInfo(struct RUInfo RU){
-  uint8_t BitMap=0;
-  if(RU.type == 1)
-    BitMap = RU.index;
-  else if (RU.type == 2)
-    BitMap = 37+RU.index;
-  else if (RU.type == 3)
-    BitMap = 53+RU.index;
-  else if (RU.type == 4)
-    BitMap = 61+RU.index;
-  else if (RU.type == 5)
-    BitMap = 65+RU.index;
-  else if (RU.type == 6)
-    BitMap = 67+RU.index;
-  else if (RU.type == 7){
-    BitMap = 137;
-    goto End;
-  }
-  BitMap = 2*BitMap;
-
-End:
-  return BitMap;
+  if (RU.type >= 0 && RU.type < RU_TYPES && RU.index >= 0 && RU.index < RU_MAX_INDEX)
+    return g_ruBitMapTable.bitMap[RU.type][RU.index];
+  return BitMapFromRUInfo(RU.type, RU.index);
 }
 
 RUData 
@@ -656,7 +705,7 @@ HEBitMap::GetRUDataFromBitMap(uint8_t TriggerBitMap, int channelNum)
   if (TriggerBitMap == 137)
   {
     RU.SetChannelWidth(160);
-    RU.SetCentralFrequency(GetCentralFrequencyFromChannelNumber(channelNum)+GetRUOffset(7, 0, channelNum));
+    RU.SetCentralFrequency(GetRUCenterFrequency(channelNum, TriggerBitMap));
     RU.SetNumberOfMimoUsers(0);
     return RU;
   }
@@ -671,37 +720,37 @@ HEBitMap::GetRUDataFromBitMap(uint8_t TriggerBitMap, int channelNum)
     if (BitMap >= 0 && BitMap < 37)
     {
       RU.SetChannelWidth(2);
-      RU.SetCentralFrequency(GetCentralFrequencyFromChannelNumber(virtualChanN)+GetRUOffset(1, BitMap, virtualChanN));
+      RU.SetCentralFrequency(GetRUCenterFrequency(virtualChanN, TriggerBitMap));
       RU.SetNumberOfMimoUsers(0);
     }
     else if (BitMap > 36 && BitMap <= 52)
     {
       RU.SetChannelWidth(4);
-      RU.SetCentralFrequency(GetCentralFrequencyFromChannelNumber(virtualChanN)+GetRUOffset(2, BitMap-37, virtualChanN));
+      RU.SetCentralFrequency(GetRUCenterFrequency(virtualChanN, TriggerBitMap));
       RU.SetNumberOfMimoUsers(0);
     }
     else if (BitMap > 52 && BitMap <= 60)
     {
       RU.SetChannelWidth(8);
-      RU.SetCentralFrequency(GetCentralFrequencyFromChannelNumber(virtualChanN)+GetRUOffset(3, BitMap-53, virtualChanN));
+      RU.SetCentralFrequency(GetRUCenterFrequency(virtualChanN, TriggerBitMap));
       RU.SetNumberOfMimoUsers(0);
     }
     else if (BitMap > 60 && BitMap <= 64)
     {
       RU.SetChannelWidth(20);
-      RU.SetCentralFrequency(GetCentralFrequencyFromChannelNumber(virtualChanN)+GetRUOffset(4, BitMap-61, virtualChanN));
+      RU.SetCentralFrequency(GetRUCenterFrequency(virtualChanN, TriggerBitMap));
       RU.SetNumberOfMimoUsers(0);
     }
     else if (BitMap > 64 && BitMap <= 66)
     {
       RU.SetChannelWidth(40);
-      RU.SetCentralFrequency(GetCentralFrequencyFromChannelNumber(virtualChanN)+GetRUOffset(5, BitMap-65, virtualChanN));
+      RU.SetCentralFrequency(GetRUCenterFrequency(virtualChanN, TriggerBitMap));
       RU.SetNumberOfMimoUsers(0);
     }
     else if (BitMap == 67 || BitMap == 68)
     {
       RU.SetChannelWidth(80);
-      RU.SetCentralFrequency(GetCentralFrequencyFromChannelNumber(virtualChanN)+GetRUOffset(6, BitMap-67, virtualChanN));
+      RU.SetCentralFrequency(GetRUCenterFrequency(virtualChanN, TriggerBitMap));
       RU.SetNumberOfMimoUsers(0);
     }
     return RU;
@@ -710,37 +759,37 @@ HEBitMap::GetRUDataFromBitMap(uint8_t TriggerBitMap, int channelNum)
   if (BitMap >= 0 && BitMap < 37)
   {
     RU.SetChannelWidth(2);
-    RU.SetCentralFrequency(GetCentralFrequencyFromChannelNumber(channelNum)+GetRUOffset(1, BitMap, channelNum));
+    RU.SetCentralFrequency(GetRUCenterFrequency(channelNum, TriggerBitMap));
     RU.SetNumberOfMimoUsers(0);
   }
   else if (BitMap > 36 && BitMap <= 52)
   {
     RU.SetChannelWidth(4);
-    RU.SetCentralFrequency(GetCentralFrequencyFromChannelNumber(channelNum)+GetRUOffset(2, BitMap-37, channelNum));
+    RU.SetCentralFrequency(GetRUCenterFrequency(channelNum, TriggerBitMap));
     RU.SetNumberOfMimoUsers(0);
   }
   else if (BitMap > 52 && BitMap <= 60)
   {
     RU.SetChannelWidth(8);
-    RU.SetCentralFrequency(GetCentralFrequencyFromChannelNumber(channelNum)+GetRUOffset(3, BitMap-53, channelNum));
+    RU.SetCentralFrequency(GetRUCenterFrequency(channelNum, TriggerBitMap));
     RU.SetNumberOfMimoUsers(0);
   }
   else if (BitMap > 60 && BitMap <= 64)
   {
     RU.SetChannelWidth(20);
-    RU.SetCentralFrequency(GetCentralFrequencyFromChannelNumber(channelNum)+GetRUOffset(4, BitMap-61, channelNum));
+    RU.SetCentralFrequency(GetRUCenterFrequency(channelNum, TriggerBitMap));
     RU.SetNumberOfMimoUsers(0);
   }
   else if (BitMap > 64 && BitMap <= 66)
   {
     RU.SetChannelWidth(40);
-    RU.SetCentralFrequency(GetCentralFrequencyFromChannelNumber(channelNum)+GetRUOffset(5, BitMap-65, channelNum));
+    RU.SetCentralFrequency(GetRUCenterFrequency(channelNum, TriggerBitMap));
     RU.SetNumberOfMimoUsers(0);
   }
   else if (BitMap == 67 || BitMap == 68)
   {
     RU.SetChannelWidth(80);
-    RU.SetCentralFrequency(GetCentralFrequencyFromChannelNumber(channelNum)+GetRUOffset(6, BitMap-67, channelNum));
+    RU.SetCentralFrequency(GetRUCenterFrequency(channelNum, TriggerBitMap));
     RU.SetNumberOfMimoUsers(0);
   }
   else
@@ -810,88 +859,27 @@ HEBitMap::SortRUData(Ptr<RUData> ru1, Ptr<RUData> ru2)
 ruVector
 HEBitMap::GetRuVectorFromRuBitMap(uint8_t BitMap)
 {
+  const RUDescriptorList &ruList = GetRuDescriptorsFromRuBitMap(BitMap);
   ruVector ruVec;
-  RUInfo ruInfo;
-  double chanWidth = 0.0;
-  uint8_t numMimoUsers = 1;
-  unsigned char ruDist[9];
-  GetRUDistFromBitMap(ruDist, BitMap);
-  int index = 0;
-  bool flag = true;
-  if (BitMap == 200)
-  {
-    Ptr<RUData> ruData = Create<RUData> ();
-    ruData->SetBitMap(130);
-    ruData->SetCentralFrequency(GetCentralFrequencyFromChannelNumber(38)+GetRUOffset(ruInfo.type, ruInfo.index, 38));
-    ruData->SetChannelWidth(40);
-    ruData->SetNumberOfMimoUsers(numMimoUsers);
-    ruVec.push_back(ruData);
-    goto End;
-  }
-  else if (BitMap == 208)
+  ruVec.reserve(ruList.count);
+  for (uint32_t i = 0; i < ruList.count; i++)
   {
     Ptr<RUData> ruData = Create<RUData> ();
-    ruData->SetBitMap(134);
-    ruData->SetCentralFrequency(GetCentralFrequencyFromChannelNumber(42)+GetRUOffset(ruInfo.type, ruInfo.index, 42));
-    ruData->SetChannelWidth(80);
-    ruData->SetNumberOfMimoUsers(numMimoUsers);
+    ruData->SetBitMap(ruList.ru[i].bitMap);
+    ruData->SetCentralFrequency(ruList.ru[i].centralFrequency);
+    ruData->SetChannelWidth(ruList.ru[i].channelWidth);
+    ruData->SetNumberOfMimoUsers(ruList.ru[i].mimoUsers);
     ruVec.push_back(ruData);
-    goto End;
   }
-  else if (BitMap == 216)
-  {
-    Ptr<RUData> ruData = Create<RUData> ();
-    ruData->SetBitMap(137);
-    ruData->SetCentralFrequency(GetCentralFrequencyFromChannelNumber(50)+GetRUOffset(ruInfo.type, ruInfo.index, 50));
-    ruData->SetChannelWidth(160);
-    ruData->SetNumberOfMimoUsers(numMimoUsers);
-    ruVec.push_back(ruData);
-    goto End;
-  }
-  for (index = 0;index < 9 && flag;)
-  {
-    ruInfo.type = ruDist[index];
-    if (ruInfo.type == 1){
-      ruInfo.index = index;
-      chanWidth = 2.0;
-      index++;
-    }
-    else if (ruInfo.type == 2){
-      int i = (index > 4) ? ( 2 + (index - 5)/2 ) : ( index/2 );
-      ruInfo.index = i;
-      chanWidth = 4.0;
-      index = index+2;
-    }
-    else if (ruInfo.type == 3){
-      ruInfo.index = (index > 4) ? 1 : 0;
-      chanWidth = 8.0;
-      index = index+4;
-    }
-    else if (ruInfo.type == 4){
-      ruInfo.index = 0;
-      chanWidth = 20.0;
-      index = index+9;
-    }
-    else{
-    index++;
-    flag = false;
-    }
-      
-    if(flag){
-      Ptr<RUData> ruData = Create<RUData> ();
-      ruData->SetBitMap(GetBitMapFromRUInfo(ruInfo));
-      ruData->SetCentralFrequency(GetCentralFrequencyFromChannelNumber(1)+GetRUOffset(ruInfo.type, ruInfo.index, 1));
-      ruData->SetChannelWidth(chanWidth);
-      ruData->SetNumberOfMimoUsers(numMimoUsers);
-      ruVec.push_back(ruData);
-    }
-    flag = true;
-  }
-End:
-  std::sort(ruVec.begin(),ruVec.end(),SortRUData);
   return ruVec;
 }
 
+const RUDescriptorList &
+HEBitMap::GetRuDescriptorsFromRuBitMap(uint8_t BitMap)
+{
+  return GetRUDescriptorTable ().list[BitMap];
+}
+
 double HEBitMap::GetRUOffset(int RUtype, int RUindex, int channelNumber)
 {
   double offset = 0.0;
@@ -902,11 +890,11 @@ double HEBitMap::GetRUOffset(int RUtype, int RUindex, int channelNumber)
   if (channelNumber%4 == 0 || (channelNumber >= 1 && channelNumber <= 11))
   {
     // 20Mhz case
-    if (RUtype == 1)
+    if (RUtype == 1 && RUindex < 9)
       offset = RUoff26[RUindex]*subcarrierSpacing;
-    else if (RUtype == 2)
+    else if (RUtype == 2 && RUindex < 4)
       offset = RUoff52[RUindex]*subcarrierSpacing;
-    else if (RUtype == 3)
+    else if (RUtype == 3 && RUindex < 2)
       offset = RUoff106[RUindex]*subcarrierSpacing;
     else if (RUtype == 4)
       offset = 0;
@@ -1098,6 +1086,17 @@ void HEBitMap::CalculateFcFromRUDist(double *Fc, unsigned char *RUrow)
   }
 }
 
+double HEBitMap::GetRUCenterFrequency(int channelNumber, int TriggerBitMap)
+{
+  const RUCenterFrequencyTable &table = GetRUCenterFrequencyTable ();
+  if (channelNumber < 0 || channelNumber > 255 || table.slot[channelNumber] < 0
+      || TriggerBitMap < 0 || TriggerBitMap >= RU_FC_TABLE_BITMAPS)
+  {
+    return ComputeRUCenterFrequency (channelNumber, TriggerBitMap);
+  }
+  return table.fc[table.slot[channelNumber]][TriggerBitMap];
+}
+
 double HEBitMap::GetCentralFrequencyFromChannelNumber2_4GHz20MHz(int channelNumber)
 {
   return (LOWER_FREQ_2_4GHZ + 6 + channelNumber*5)*1e6;
@@ -43,6 +43,23 @@ struct RUInfo{
   int index;
 };
 
+/* Largest number of RUs in a PPDU: 74 RUs of 26 tones in 160 Mhz */
+#define HE_MAX_RU_COUNT 74
+
+/* Value type counterpart of RUData */
+struct RUDescriptor{
+  uint8_t bitMap;
+  uint8_t mimoUsers;
+  double centralFrequency;
+  double channelWidth;
+};
+
+/* Fixed capacity list of the RUs of an MU PPDU, widest RU first */
+struct RUDescriptorList{
+  uint32_t count;
+  RUDescriptor ru[HE_MAX_RU_COUNT];
+};
+
 class RUData : public SimpleRefCount <RUData>
 {
 public:
@@ -91,24 +108,43 @@ public:
 
   void GetRUDistFromBitMap(unsigned char *row, int BitMapValue);
 
-  RUInfo GetRUInfoFromTriggerBitMap(int BitMapValue);
+  static RUInfo GetRUInfoFromTriggerBitMap(int BitMapValue);
   
   RUData GetRUDataFromBitMap(uint8_t BitMapValue, int channelNumber);
   
-  uint8_t GetBitMapFromRUInfo(struct RUInfo RU);
+  static uint8_t GetBitMapFromRUInfo(struct RUInfo RU);
 
-  double GetRUOffset(int RUtype, int RUindex, int channelNumber);
+  static double GetRUOffset(int RUtype, int RUindex, int channelNumber);
 
   void CalculateFcFromRUDist(double *Fc, unsigned char *RUrow);
 
   double GetCentralFrequencyFromChannelNumber2_4GHz20MHz(int channelNumber);
 
-  double GetCentralFrequencyFromChannelNumber(int channelNumber);
+  static double GetCentralFrequencyFromChannelNumber(int channelNumber);
+
+  /* Center frequency (Hz) of the RU addressed by a trigger frame bitmap on
+   * the given channel. Served from a table built once per process from
+   * GetCentralFrequencyFromChannelNumber and GetRUOffset; channel numbers
+   * or bitmaps outside of the table are computed on the fly. */
+  static double GetRUCenterFrequency(int channelNumber, int TriggerBitMap);
 
   ruVector GetRuVectorFromRuBitMap(uint8_t BitMap);
 
+  /* Allocation free variant of GetRuVectorFromRuBitMap. The returned list
+   * lives in a table built once per process and must not be modified. */
+  static const RUDescriptorList &GetRuDescriptorsFromRuBitMap(uint8_t BitMap);
+
   double GetDataRate(uint32_t mcsVal, uint32_t chanW);
 
+  /* Data rate in bit/s of an RU of the given type (1: 26 tones .. 7: 2x996
+   * tones) for HE MCS 0-11, a guard interval of 800, 1600 or 3200 ns and
+   * 1 to 8 spatial streams; 0 for any other combination. Served from a
+   * table generated at compile time from the RU data subcarrier counts. */
+  static double GetHeDataRate(int RUtype, uint32_t mcsVal, uint32_t guardInterval, uint32_t nss);
+
+  /* RU type of an RU of the given width in Mhz (2, 4, 8, 20, 40, 80, 160), 0 if none */
+  static int GetRUTypeFromChannelWidth(uint32_t chanW);
+
   mapIndexVector GetMapVectorFromUserCount(int numUsers, bool isMimo, int numMimoUsers);
  
   static bool SortRUData(Ptr<RUData> ru1, Ptr<RUData> ru2);
@@ -119,9 +155,6 @@ public:
   int m_DataBitMap;
   RUInfo m_RU;
   int m_TriggerBitMap;
-
-private:
-  MuPPDUBitMapTable m_RUDistTable;
 };
 
 }
@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/he-bitmap.h"
+#include "he-bsr-ul-scheduler.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("HeBsrUlScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (HeBsrUlScheduler);
+
+TypeId
+HeBsrUlScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::HeBsrUlScheduler")
+    .SetParent<HePfScheduler> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<HeBsrUlScheduler> ()
+    .AddAttribute ("PollInterval",
+                   "Minimum time between two polls of a station whose buffer status is stale",
+                   TimeValue (MilliSeconds (10)),
+                   MakeTimeAccessor (&HeBsrUlScheduler::m_pollInterval),
+                   MakeTimeChecker ())
+    .AddAttribute ("MaxPollDelay",
+                   "Time after which a station with a stale buffer status is polled "
+                   "even if other stations have reported data",
+                   TimeValue (MilliSeconds (50)),
+                   MakeTimeAccessor (&HeBsrUlScheduler::m_maxPollDelay),
+                   MakeTimeChecker ())
+    .AddTraceSource ("Polls",
+                     "Number of stations polled for their buffer status",
+                     MakeTraceSourceAccessor (&HeBsrUlScheduler::m_polls),
+                     "ns3::TracedValueCallback::Uint32")
+  ;
+  return tid;
+}
+
+HeBsrUlScheduler::HeBsrUlScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+  m_polls = 0;
+}
+
+HeBsrUlScheduler::~HeBsrUlScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+HeBsrUlScheduler::ScheduleUplink (const HeStationSnapshotList &stations,
+                                  HeRuAssignmentList &assignments)
+{
+  NS_LOG_FUNCTION (this << stations.size ());
+  Time now = Simulator::Now ();
+  std::vector<uint32_t> due;
+  bool hasData = FindStaleStations (stations);
+  bool overdue = false;
+
+  for (uint32_t i = 0; i < stations.size (); i++)
+    {
+      uint16_t aid = stations[i].aid;
+      if (m_stationEntry[aid] != (int)i || now - m_lastPoll[aid] < m_pollInterval)
+        {
+          continue;
+        }
+      due.push_back (i);
+      overdue |= now - m_lastPoll[aid] >= m_maxPollDelay;
+    }
+
+  if (!due.empty () && (!hasData || overdue))
+    {
+      Poll (stations, due, assignments);
+      return;
+    }
+  HePfScheduler::ScheduleUplink (stations, assignments);
+}
+
+void
+HeBsrUlScheduler::CommitUplink (const HeStationSnapshotList &stations,
+                                const HeRuAssignmentList &assignments)
+{
+  NS_LOG_FUNCTION (this << assignments.size ());
+  Time now = Simulator::Now ();
+  std::vector<bool> granted;
+  bool polled = false;
+
+  for (HeRuAssignmentList::const_iterator it = assignments.begin (); it != assignments.end (); it++)
+    {
+      if (it->index >= granted.size ())
+        {
+          granted.resize (it->index + 1, false);
+        }
+      granted[it->index] = true;
+    }
+  // A poll only grants stale stations, a data round only fresh ones
+  FindStaleStations (stations);
+  for (uint32_t i = 0; i < stations.size (); i++)
+    {
+      const HeStationSnapshot &entry = stations[i];
+      if (m_stationEntry[entry.aid] != (int)i || entry.index >= granted.size () || !granted[entry.index])
+        {
+          continue;
+        }
+      m_lastPoll[entry.aid] = now;
+      m_polls++;
+      polled = true;
+    }
+  if (!polled)
+    {
+      HePfScheduler::CommitUplink (stations, assignments);
+    }
+}
+
+bool
+HeBsrUlScheduler::FindStaleStations (const HeStationSnapshotList &stations)
+{
+  bool hasData = false;
+
+  // All the ACs of a station are reported together: the station is stale
+  // when none of its queues has a valid buffer status
+  std::fill (m_stationEntry.begin (), m_stationEntry.end (), -1);
+  for (uint32_t i = 0; i < stations.size (); i++)
+    {
+      const HeStationSnapshot &entry = stations[i];
+      if (entry.aid >= m_stationEntry.size ())
+        {
+          m_stationEntry.resize (entry.aid + 1, -1);
+          m_lastPoll.resize (entry.aid + 1, Seconds (0));
+        }
+      if (entry.bufferDepthUL != 0xffffffff)
+        {
+          // -2 marks a station with a valid report
+          m_stationEntry[entry.aid] = -2;
+          hasData |= entry.bufferDepthUL > 0;
+        }
+      else if (m_stationEntry[entry.aid] == -1)
+        {
+          m_stationEntry[entry.aid] = i;
+        }
+    }
+  return hasData;
+}
+
+void
+HeBsrUlScheduler::Poll (const HeStationSnapshotList &stations, std::vector<uint32_t> &due,
+                        HeRuAssignmentList &assignments) const
+{
+  NS_LOG_FUNCTION (this << due.size ());
+  uint32_t nRus = (m_channelWidth == 160) ? 74 : (m_channelWidth == 80) ? 37 : 9 * m_channelWidth / 20;
+
+  std::sort (due.begin (), due.end (),
+             [this, &stations] (uint32_t a, uint32_t b)
+             { return m_lastPoll[stations[a].aid] < m_lastPoll[stations[b].aid]; });
+  if (due.size () > nRus)
+    {
+      due.resize (nRus);
+    }
+  assignments.clear ();
+  for (uint32_t k = 0; k < due.size (); k++)
+    {
+      const HeStationSnapshot &entry = stations[due[k]];
+      RUInfo ru;
+      // The 26 tone RUs of the second 80 Mhz segment carry the segment bit
+      ru.type = 1;
+      ru.index = k % 37;
+      HeRuAssignment assignment;
+      assignment.index = entry.index;
+      assignment.ruBitMap = HEBitMap::GetBitMapFromRUInfo (ru) + k / 37;
+      assignment.mcs = 0;
+      assignment.chanW = 2;
+      assignments.push_back (assignment);
+    }
+}
+
+} // namespace ns3
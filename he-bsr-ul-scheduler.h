@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#ifndef HE_BSR_UL_SCHEDULER_H
+#define HE_BSR_UL_SCHEDULER_H
+
+#include "ns3/traced-value.h"
+#include "he-pf-scheduler.h"
+
+namespace ns3 {
+
+/**
+ * \brief HE MU scheduler triggering stations from their buffer status reports
+ *
+ * The downlink is scheduled as by HePfScheduler. In the uplink, only the
+ * stations with a fresh, non zero buffer status are triggered, on RUs
+ * sized after their reported backlog. The stations whose buffer status is
+ * unknown or stale are polled with a 26 tone RU at MCS 0, for the AP to
+ * learn their backlog from the response, instead of being granted large
+ * RUs they may leave empty. A station is polled at most once per
+ * PollInterval; polling rounds only preempt data rounds for stations left
+ * unpolled for MaxPollDelay. The poll time of a station is recorded when
+ * the poll is committed.
+ */
+class HeBsrUlScheduler : public HePfScheduler
+{
+public:
+  static TypeId GetTypeId (void);
+
+  HeBsrUlScheduler ();
+  virtual ~HeBsrUlScheduler ();
+
+  virtual void ScheduleUplink (const HeStationSnapshotList &stations,
+                               HeRuAssignmentList &assignments);
+  virtual void CommitUplink (const HeStationSnapshotList &stations,
+                             const HeRuAssignmentList &assignments);
+
+private:
+  /**
+   * Fill m_stationEntry with the snapshot position of one queue of each
+   * stale station, -2 for the stations with a valid buffer status
+   *
+   * \param stations the AP queues
+   * \return true if a station reported a non empty buffer
+   */
+  bool FindStaleStations (const HeStationSnapshotList &stations);
+  /**
+   * Grant a 26 tone RU to each of the stations due for a poll, oldest poll first
+   *
+   * \param stations the AP queues
+   * \param due the snapshot positions of one queue of each station to poll
+   * \param assignments the RUs of the next PPDU
+   */
+  void Poll (const HeStationSnapshotList &stations, std::vector<uint32_t> &due,
+             HeRuAssignmentList &assignments) const;
+
+  Time m_pollInterval;                    //!< Minimum time between two polls of a station
+  Time m_maxPollDelay;                    //!< Time after which a poll preempts data
+  std::vector<Time> m_lastPoll;           //!< Last poll of each station, by AID
+  std::vector<int> m_stationEntry;        //!< Snapshot position of each station, by AID
+  TracedValue<uint32_t> m_polls;          //!< Stations polled so far
+};
+
+} // namespace ns3
+
+#endif /* HE_BSR_UL_SCHEDULER_H */
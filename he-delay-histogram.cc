@@ -0,0 +1,188 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+
+#include "he-delay-histogram.h"
+
+namespace ns3 {
+
+// Values below 2^SUB_BUCKET_BITS have a bucket of their own, each power of
+// two above is split in 2^(SUB_BUCKET_BITS - 1) buckets
+#define HE_DELAY_SUB_BUCKET_BITS 7
+#define HE_DELAY_HALF_SUB_BUCKETS (1 << (HE_DELAY_SUB_BUCKET_BITS - 1))
+
+HeDelayHistogram::HeDelayHistogram ()
+{
+  Reset ();
+}
+
+HeDelayHistogram::~HeDelayHistogram ()
+{
+}
+
+void
+HeDelayHistogram::Reset (void)
+{
+  m_counts.clear ();
+  m_count = 0;
+  m_min = 0;
+  m_max = 0;
+  m_sum = 0;
+}
+
+uint32_t
+HeDelayHistogram::GetBucket (uint64_t value)
+{
+  if (value < 2 * HE_DELAY_HALF_SUB_BUCKETS)
+    {
+      return value;
+    }
+  uint32_t shift = 1;
+  while ((value >> shift) >= 2 * HE_DELAY_HALF_SUB_BUCKETS)
+    {
+      shift++;
+    }
+  return shift * HE_DELAY_HALF_SUB_BUCKETS + (value >> shift);
+}
+
+uint64_t
+HeDelayHistogram::GetBucketStart (uint32_t bucket)
+{
+  if (bucket < 2 * HE_DELAY_HALF_SUB_BUCKETS)
+    {
+      return bucket;
+    }
+  uint32_t shift = bucket / HE_DELAY_HALF_SUB_BUCKETS - 1;
+  return (uint64_t)(bucket - shift * HE_DELAY_HALF_SUB_BUCKETS) << shift;
+}
+
+uint64_t
+HeDelayHistogram::GetBucketWidth (uint32_t bucket)
+{
+  if (bucket < 2 * HE_DELAY_HALF_SUB_BUCKETS)
+    {
+      return 1;
+    }
+  return (uint64_t)1 << (bucket / HE_DELAY_HALF_SUB_BUCKETS - 1);
+}
+
+void
+HeDelayHistogram::Add (uint64_t value)
+{
+  uint32_t bucket = GetBucket (value);
+  if (bucket >= m_counts.size ())
+    {
+      m_counts.resize (bucket + 1, 0);
+    }
+  m_counts[bucket]++;
+  if (m_count == 0 || value < m_min)
+    {
+      m_min = value;
+    }
+  if (value > m_max)
+    {
+      m_max = value;
+    }
+  m_count++;
+  m_sum += value;
+}
+
+uint64_t
+HeDelayHistogram::GetCount (void) const
+{
+  return m_count;
+}
+
+uint64_t
+HeDelayHistogram::GetMin (void) const
+{
+  return m_min;
+}
+
+uint64_t
+HeDelayHistogram::GetMax (void) const
+{
+  return m_max;
+}
+
+double
+HeDelayHistogram::GetMean (void) const
+{
+  return m_count ? m_sum / m_count : 0;
+}
+
+uint64_t
+HeDelayHistogram::GetValueAtRank (uint64_t rank) const
+{
+  if (rank == 0 || rank > m_count)
+    {
+      return 0;
+    }
+  if (rank == 1)
+    {
+      return m_min;
+    }
+  if (rank == m_count)
+    {
+      return m_max;
+    }
+  uint64_t seen = 0;
+  for (uint32_t bucket = 0; bucket < m_counts.size (); bucket++)
+    {
+      seen += m_counts[bucket];
+      if (seen >= rank)
+        {
+          // Middle of the bucket, within the exact extremes
+          uint64_t value = GetBucketStart (bucket) + GetBucketWidth (bucket) / 2;
+          return value < m_min ? m_min : value > m_max ? m_max : value;
+        }
+    }
+  return m_max;
+}
+
+uint64_t
+HeDelayHistogram::GetPercentile (uint32_t percent) const
+{
+  return GetValueAtRank (m_count * percent / 100);
+}
+
+uint64_t
+HeDelayHistogram::GetCountBelow (uint64_t bound) const
+{
+  if (bound > m_max)
+    {
+      return m_count;
+    }
+  if (bound <= m_min)
+    {
+      return 0;
+    }
+  uint32_t last = GetBucket (bound);
+  uint64_t below = 0;
+  for (uint32_t bucket = 0; bucket < last; bucket++)
+    {
+      below += m_counts[bucket];
+    }
+  uint64_t start = GetBucketStart (last);
+  below += m_counts[last] * (bound - start) / GetBucketWidth (last);
+  return below;
+}
+
+} // namespace ns3
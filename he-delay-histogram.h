@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+
+#ifndef HE_DELAY_HISTOGRAM_H
+#define HE_DELAY_HISTOGRAM_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Bounded memory distribution of delay samples
+ *
+ * The samples, e.g. latencies or jitters in nanoseconds, are counted in
+ * log-linear buckets as in an HDR histogram: the values below 128 have a
+ * bucket of their own, and every power of two above is split in 64
+ * buckets of equal width. Any value is thus known within 1/128 of itself,
+ * with at most 3776 buckets for the whole uint64_t range, and a few hundred
+ * for the delays of a simulation. The buckets are only allocated up to the
+ * largest value seen.
+ *
+ * The count, mean, minimum and maximum are exact; the quantiles and the
+ * counts below a bound are read from the buckets.
+ */
+class HeDelayHistogram
+{
+public:
+  HeDelayHistogram ();
+  ~HeDelayHistogram ();
+
+  /**
+   * Forget all the samples
+   */
+  void Reset (void);
+  /**
+   * \param value the sample to record
+   */
+  void Add (uint64_t value);
+  /**
+   * \return the number of samples
+   */
+  uint64_t GetCount (void) const;
+  /**
+   * \return the smallest sample, 0 if there is none
+   */
+  uint64_t GetMin (void) const;
+  /**
+   * \return the largest sample, 0 if there is none
+   */
+  uint64_t GetMax (void) const;
+  /**
+   * \return the mean of the samples, 0 if there is none
+   */
+  double GetMean (void) const;
+  /**
+   * \param rank rank of the sample, from 1 for the smallest to GetCount ()
+   * \return the value of the sample of that rank, that is the element rank - 1
+   *         of the sorted samples, 0 if rank is 0 or above GetCount ()
+   */
+  uint64_t GetValueAtRank (uint64_t rank) const;
+  /**
+   * \param percent the percentile, in ]0, 100]
+   * \return the value of the sample of rank GetCount () * percent / 100,
+   *         rounded down
+   */
+  uint64_t GetPercentile (uint32_t percent) const;
+  /**
+   * \param bound the exclusive upper bound
+   * \return the number of samples below the bound, interpolated within the
+   *         bucket holding the bound
+   */
+  uint64_t GetCountBelow (uint64_t bound) const;
+
+private:
+  /**
+   * \return the bucket holding the value
+   */
+  static uint32_t GetBucket (uint64_t value);
+  /**
+   * \return the smallest value held by the bucket
+   */
+  static uint64_t GetBucketStart (uint32_t bucket);
+  /**
+   * \return the number of values held by the bucket
+   */
+  static uint64_t GetBucketWidth (uint32_t bucket);
+
+  std::vector<uint64_t> m_counts;   //!< Samples of each bucket
+  uint64_t m_count;                 //!< Samples recorded
+  uint64_t m_min;                   //!< Smallest sample
+  uint64_t m_max;                   //!< Largest sample
+  double m_sum;                     //!< Sum of the samples
+};
+
+} // namespace ns3
+
+#endif /* HE_DELAY_HISTOGRAM_H */
@@ -0,0 +1,222 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/qos-utils.h"
+#include "he-edf-scheduler.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("HeEdfScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (HeEdfScheduler);
+
+/* Metric bonus of the most urgent station, larger than any PF metric so
+ * that urgent stations always win an RU over the others */
+static const double g_urgentBonus = 1e12;
+
+TypeId
+HeEdfScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::HeEdfScheduler")
+    .SetParent<HePfScheduler> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<HeEdfScheduler> ()
+    .AddAttribute ("VoDelayBudget",
+                   "Maximum time a VO packet should wait in the AP queue",
+                   TimeValue (MilliSeconds (30)),
+                   MakeTimeAccessor (&HeEdfScheduler::m_voDelayBudget),
+                   MakeTimeChecker ())
+    .AddAttribute ("ViDelayBudget",
+                   "Maximum time a VI packet should wait in the AP queue",
+                   TimeValue (MilliSeconds (100)),
+                   MakeTimeAccessor (&HeEdfScheduler::m_viDelayBudget),
+                   MakeTimeChecker ())
+    .AddAttribute ("Horizon",
+                   "Time to deadline under which a VO or VI station is served "
+                   "before the proportional fair ones",
+                   TimeValue (MilliSeconds (20)),
+                   MakeTimeAccessor (&HeEdfScheduler::m_horizon),
+                   MakeTimeChecker ())
+    .AddTraceSource ("VoDeadlineMisses",
+                     "Number of VO head of line packets queued past their deadline",
+                     MakeTraceSourceAccessor (&HeEdfScheduler::m_voDeadlineMisses),
+                     "ns3::TracedValueCallback::Uint32")
+    .AddTraceSource ("ViDeadlineMisses",
+                     "Number of VI head of line packets queued past their deadline",
+                     MakeTraceSourceAccessor (&HeEdfScheduler::m_viDeadlineMisses),
+                     "ns3::TracedValueCallback::Uint32")
+  ;
+  return tid;
+}
+
+HeEdfScheduler::HeEdfScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+  m_voDeadlineMisses = 0;
+  m_viDeadlineMisses = 0;
+}
+
+HeEdfScheduler::~HeEdfScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+HeEdfScheduler::ScheduleDownlink (const HeStationSnapshotList &stations,
+                                  HeRuAssignmentList &assignments)
+{
+  NS_LOG_FUNCTION (this << stations.size ());
+  CandidateList candidates;
+
+  SelectDownlinkCandidates (stations, candidates);
+  PackRus (candidates, assignments);
+}
+
+void
+HeEdfScheduler::CommitDownlink (const HeStationSnapshotList &stations,
+                                const HeRuAssignmentList &assignments)
+{
+  NS_LOG_FUNCTION (this << assignments.size ());
+  CandidateList candidates;
+
+  CountDeadlineMisses (stations);
+  SelectDownlinkCandidates (stations, candidates);
+  UpdateAverages (m_averageDL, stations, candidates, assignments);
+}
+
+void
+HeEdfScheduler::SelectDownlinkCandidates (const HeStationSnapshotList &stations,
+                                          CandidateList &candidates)
+{
+  std::vector<int> slot;
+  std::vector<int> urgentEntry;
+  std::vector<Time> slack;
+  std::vector<std::pair<Time, uint32_t> > urgent;
+
+  SelectCandidates (stations, true, candidates);
+  for (uint32_t c = 0; c < candidates.size (); c++)
+    {
+      if (candidates[c].aid >= slot.size ())
+        {
+          slot.resize (candidates[c].aid + 1, -1);
+        }
+      slot[candidates[c].aid] = c;
+    }
+  // Earliest deadline across the VO and VI queues of each station: the
+  // highest priority AC picked by SelectCandidates may not be the most
+  // urgent one
+  urgentEntry.assign (candidates.size (), -1);
+  slack.resize (candidates.size ());
+  for (uint32_t i = 0; i < stations.size (); i++)
+    {
+      const HeStationSnapshot &entry = stations[i];
+      Time budget = GetDelayBudget (entry.ac);
+      if (budget.IsZero () || entry.bufferDepthDL == 0 || !entry.needsAccess)
+        {
+          continue;
+        }
+      // A queue with a DL backlog always makes its station a candidate
+      int c = slot[entry.aid];
+      Time entrySlack = budget - entry.waitingTimeDL;
+      if (entrySlack <= m_horizon && (urgentEntry[c] < 0 || entrySlack < slack[c]))
+        {
+          urgentEntry[c] = i;
+          slack[c] = entrySlack;
+        }
+    }
+  for (uint32_t c = 0; c < candidates.size (); c++)
+    {
+      if (urgentEntry[c] < 0)
+        {
+          continue;
+        }
+      // Serve the station for its most urgent queue
+      const HeStationSnapshot &entry = stations[urgentEntry[c]];
+      Candidate &candidate = candidates[c];
+      candidate.index = entry.index;
+      candidate.entry = urgentEntry[c];
+      candidate.ac = entry.ac;
+      candidate.demand = entry.bufferDepthDL * 8.0;
+      urgent.push_back (std::make_pair (slack[c], c));
+    }
+  // Earliest deadline first: the bonus decreases with the slack
+  std::sort (urgent.begin (), urgent.end ());
+  for (uint32_t k = 0; k < urgent.size (); k++)
+    {
+      Candidate &candidate = candidates[urgent[k].second];
+      candidate.bonus = g_urgentBonus * (urgent.size () - k) / urgent.size ();
+      NS_LOG_DEBUG ("AID " << candidate.aid << " AC " << (uint32_t)candidate.ac
+                    << " urgent, slack " << urgent[k].first.GetMicroSeconds () << "us");
+    }
+}
+
+Time
+HeEdfScheduler::GetDelayBudget (uint8_t ac) const
+{
+  switch (ac)
+    {
+    case AC_VO:
+      return m_voDelayBudget;
+    case AC_VI:
+      return m_viDelayBudget;
+    default:
+      return Seconds (0);
+    }
+}
+
+void
+HeEdfScheduler::CountDeadlineMisses (const HeStationSnapshotList &stations)
+{
+  Time now = Simulator::Now ();
+
+  for (HeStationSnapshotList::const_iterator it = stations.begin (); it != stations.end (); it++)
+    {
+      Time budget = GetDelayBudget (it->ac);
+      if (budget.IsZero () || it->bufferDepthDL == 0 || it->waitingTimeDL <= budget)
+        {
+          continue;
+        }
+      if (it->index >= m_missedHol.size ())
+        {
+          m_missedHol.resize (it->index + 1, Seconds (-1));
+        }
+      // The same late packet stays at the head of the queue until it is sent
+      Time queued = now - it->waitingTimeDL;
+      if (queued == m_missedHol[it->index])
+        {
+          continue;
+        }
+      m_missedHol[it->index] = queued;
+      if (it->ac == AC_VO)
+        {
+          m_voDeadlineMisses++;
+        }
+      else
+        {
+          m_viDeadlineMisses++;
+        }
+    }
+}
+
+} // namespace ns3
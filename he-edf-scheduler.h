@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#ifndef HE_EDF_SCHEDULER_H
+#define HE_EDF_SCHEDULER_H
+
+#include "ns3/traced-value.h"
+#include "he-pf-scheduler.h"
+
+namespace ns3 {
+
+/**
+ * \brief HE MU scheduler serving the VO and VI queues by earliest deadline
+ *
+ * The head of line packet of a VO (resp. VI) queue is due VoDelayBudget
+ * (resp. ViDelayBudget) after it was queued, and the deadline of a station
+ * is the earliest of its VO and VI queues. In the downlink, the stations
+ * whose deadline falls within Horizon are served for that queue and packed
+ * before the others, in the
+ * order of their deadlines: the earlier the deadline, the larger the bonus
+ * added to their PF metric, so that RUs are split until every urgent
+ * station has one. The remaining RUs, and the uplink, where the AP does
+ * not know the age of the buffered packets, are scheduled as by
+ * HePfScheduler.
+ *
+ * A VO or VI head of line packet still queued past its deadline when a DL
+ * PPDU is committed is counted once in the VoDeadlineMisses or
+ * ViDeadlineMisses trace source.
+ */
+class HeEdfScheduler : public HePfScheduler
+{
+public:
+  static TypeId GetTypeId (void);
+
+  HeEdfScheduler ();
+  virtual ~HeEdfScheduler ();
+
+  virtual void ScheduleDownlink (const HeStationSnapshotList &stations,
+                                 HeRuAssignmentList &assignments);
+  virtual void CommitDownlink (const HeStationSnapshotList &stations,
+                               const HeRuAssignmentList &assignments);
+
+private:
+  /**
+   * Build one candidate per station with a DL backlog, for its VO or VI
+   * queue with the earliest deadline if it falls within Horizon, for its
+   * highest priority AC otherwise
+   *
+   * \param stations the AP queues
+   * \param candidates the stations competing in the round
+   */
+  void SelectDownlinkCandidates (const HeStationSnapshotList &stations, CandidateList &candidates);
+  /**
+   * \return the delay budget of the access category, 0 if it has none
+   */
+  Time GetDelayBudget (uint8_t ac) const;
+  /**
+   * Count the VO and VI head of line packets which missed their deadline
+   *
+   * \param stations the AP queues
+   */
+  void CountDeadlineMisses (const HeStationSnapshotList &stations);
+
+  Time m_voDelayBudget;                   //!< Delay budget of the VO queues
+  Time m_viDelayBudget;                   //!< Delay budget of the VI queues
+  Time m_horizon;                         //!< Slack under which a station is urgent
+  std::vector<Time> m_missedHol;          //!< Queue time of the last late packet counted, by HeStationSnapshot::index
+  TracedValue<uint32_t> m_voDeadlineMisses; //!< VO packets queued past their deadline
+  TracedValue<uint32_t> m_viDeadlineMisses; //!< VI packets queued past their deadline
+};
+
+} // namespace ns3
+
+#endif /* HE_EDF_SCHEDULER_H */
@@ -0,0 +1,465 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+#include "ns3/qos-utils.h"
+#include "ns3/he-bitmap.h"
+#include "he-pf-scheduler.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("HePfScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (HePfScheduler);
+
+/* RU width in Mhz by RU type, as expected in HeRuAssignment::chanW */
+static const uint8_t g_ruChannelWidth[8] = {0, 2, 4, 8, 20, 40, 80, 160};
+
+/* 26 tone RUs of a 20 Mhz channel covered by its four 52 tone RUs, the
+ * fifth 26 tone RU (index 4) being the center one */
+static const int g_ru26Of52[4][2] = {{0, 1}, {2, 3}, {5, 6}, {7, 8}};
+
+TypeId
+HePfScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::HePfScheduler")
+    .SetParent<HeSchedulerPlugin> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<HePfScheduler> ()
+    .AddAttribute ("ChannelWidth",
+                   "Width in Mhz of the channel shared by the RUs (20, 40, 80 or 160)",
+                   UintegerValue (20),
+                   MakeUintegerAccessor (&HePfScheduler::m_channelWidth),
+                   MakeUintegerChecker<uint32_t> (20, 160))
+    .AddAttribute ("PpduDuration",
+                   "Duration of the HE MU PPDU the RUs are granted for",
+                   TimeValue (MicroSeconds (5472)),
+                   MakeTimeAccessor (&HePfScheduler::m_ppduDuration),
+                   MakeTimeChecker ())
+    .AddAttribute ("TimeConstant",
+                   "Number of rounds over which the average throughput is smoothed",
+                   DoubleValue (100),
+                   MakeDoubleAccessor (&HePfScheduler::m_timeConstant),
+                   MakeDoubleChecker<double> (1))
+  ;
+  return tid;
+}
+
+HePfScheduler::HePfScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+HePfScheduler::~HePfScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+HePfScheduler::ScheduleDownlink (const HeStationSnapshotList &stations,
+                                 HeRuAssignmentList &assignments)
+{
+  NS_LOG_FUNCTION (this << stations.size ());
+  CandidateList candidates;
+
+  SelectCandidates (stations, true, candidates);
+  PackRus (candidates, assignments);
+}
+
+void
+HePfScheduler::CommitDownlink (const HeStationSnapshotList &stations,
+                               const HeRuAssignmentList &assignments)
+{
+  NS_LOG_FUNCTION (this << assignments.size ());
+  CandidateList candidates;
+
+  SelectCandidates (stations, true, candidates);
+  UpdateAverages (m_averageDL, stations, candidates, assignments);
+}
+
+void
+HePfScheduler::ScheduleUplink (const HeStationSnapshotList &stations,
+                               HeRuAssignmentList &assignments)
+{
+  NS_LOG_FUNCTION (this << stations.size ());
+  CandidateList candidates;
+
+  SelectCandidates (stations, false, candidates);
+  PackRus (candidates, assignments);
+}
+
+void
+HePfScheduler::CommitUplink (const HeStationSnapshotList &stations,
+                             const HeRuAssignmentList &assignments)
+{
+  NS_LOG_FUNCTION (this << assignments.size ());
+  CandidateList candidates;
+
+  SelectCandidates (stations, false, candidates);
+  UpdateAverages (m_averageUL, stations, candidates, assignments);
+}
+
+void
+HePfScheduler::SelectCandidates (const HeStationSnapshotList &stations, bool isDownlink,
+                                 CandidateList &candidates)
+{
+  std::vector<int> best;
+
+  candidates.clear ();
+  // Highest priority AC with a backlog of each station. In the uplink,
+  // only the stations which reported a backlog can be triggered.
+  for (uint32_t i = 0; i < stations.size (); i++)
+    {
+      const HeStationSnapshot &entry = stations[i];
+      uint32_t depth = isDownlink ? entry.bufferDepthDL : entry.bufferDepthUL;
+      if (depth == 0 || (isDownlink && !entry.needsAccess) || (!isDownlink && depth == 0xffffffff))
+        {
+          continue;
+        }
+      if (entry.aid >= best.size ())
+        {
+          best.resize (entry.aid + 1, -1);
+        }
+      int &slot = best[entry.aid];
+      if (slot < 0)
+        {
+          Candidate candidate;
+          candidate.aid = entry.aid;
+          slot = candidates.size ();
+          candidates.push_back (candidate);
+        }
+      else if (GetAcPriority (entry.ac) <= GetAcPriority (candidates[slot].ac))
+        {
+          continue;
+        }
+      Candidate &candidate = candidates[slot];
+      candidate.index = entry.index;
+      candidate.entry = i;
+      candidate.ac = entry.ac;
+      candidate.mcs = entry.mcs;
+      candidate.demand = depth * 8.0;
+      candidate.weight = GetAverage (isDownlink ? m_averageDL : m_averageUL, entry.aid);
+      candidate.bonus = 0;
+    }
+}
+
+void
+HePfScheduler::PackRus (const CandidateList &allCandidates, HeRuAssignmentList &assignments)
+{
+  NS_LOG_FUNCTION (this << allCandidates.size ());
+  RuNode children[3];
+  std::vector<RuNode> leaves;
+  std::vector<bool> served;
+  CandidateList candidates (allCandidates);
+
+  assignments.clear ();
+  if (candidates.empty ())
+    {
+      return;
+    }
+  // No more stations than twice the 26 tone RUs can win one, keep the
+  // best ones on the smallest RU to bound the search
+  size_t maxCandidates = 2 * HE_MAX_RU_COUNT * m_channelWidth / 160;
+  if (candidates.size () > maxCandidates)
+    {
+      std::nth_element (candidates.begin (), candidates.begin () + maxCandidates, candidates.end (),
+                        [this] (const Candidate &a, const Candidate &b)
+                        { return GetMetric (a, 1) > GetMetric (b, 1); });
+      candidates.resize (maxCandidates);
+    }
+  served.assign (candidates.size (), false);
+
+  RuNode root;
+  root.type = HEBitMap::GetRUTypeFromChannelWidth (m_channelWidth);
+  root.index = 0;
+  root.segment = 0;
+  root.owner = -1;
+  NS_ASSERT_MSG (root.type >= 4, "Unsupported channel width " << m_channelWidth);
+  double bestMetric = 0;
+  for (uint32_t c = 0; c < candidates.size (); c++)
+    {
+      double metric = GetMetric (candidates[c], root.type);
+      if (metric > bestMetric)
+        {
+          bestMetric = metric;
+          root.owner = c;
+        }
+    }
+  if (root.owner < 0)
+    {
+      return;
+    }
+  served[root.owner] = true;
+  leaves.push_back (root);
+
+  // Split the RU bringing the largest gain until no split pays off
+  while (true)
+    {
+      double bestGain = 0;
+      int bestLeaf = -1;
+      int bestCount = 0;
+      RuNode bestChildren[3];
+
+      for (uint32_t l = 0; l < leaves.size (); l++)
+        {
+          const RuNode &leaf = leaves[l];
+          int count = GetChildren (leaf, children);
+          if (count == 0)
+            {
+              continue;
+            }
+          // The current owner moves to the child it benefits most from
+          int ownerChild = 0;
+          double ownerMetric = -1;
+          for (int k = 0; k < count; k++)
+            {
+              double metric = GetMetric (candidates[leaf.owner], children[k].type);
+              if (metric > ownerMetric)
+                {
+                  ownerMetric = metric;
+                  ownerChild = k;
+                }
+            }
+          double total = ownerMetric;
+          children[ownerChild].owner = leaf.owner;
+          // The other children go to the best stations not served yet
+          for (int k = 0; k < count; k++)
+            {
+              if (k == ownerChild)
+                {
+                  continue;
+                }
+              double childMetric = 0;
+              children[k].owner = -1;
+              for (uint32_t c = 0; c < candidates.size (); c++)
+                {
+                  if (served[c] || (k > 0 && children[0].owner == (int)c)
+                      || (k > 1 && children[1].owner == (int)c))
+                    {
+                      continue;
+                    }
+                  double metric = GetMetric (candidates[c], children[k].type);
+                  if (metric > childMetric)
+                    {
+                      childMetric = metric;
+                      children[k].owner = c;
+                    }
+                }
+              total += childMetric;
+            }
+          double gain = total - GetMetric (candidates[leaf.owner], leaf.type);
+          if (gain > bestGain)
+            {
+              bestGain = gain;
+              bestLeaf = l;
+              bestCount = count;
+              std::copy (children, children + count, bestChildren);
+            }
+        }
+      if (bestLeaf < 0)
+        {
+          break;
+        }
+      leaves.erase (leaves.begin () + bestLeaf);
+      for (int k = 0; k < bestCount; k++)
+        {
+          if (bestChildren[k].owner >= 0)
+            {
+              served[bestChildren[k].owner] = true;
+              leaves.push_back (bestChildren[k]);
+            }
+        }
+    }
+
+  // The greedy splits fix the layout, the owners are then matched to its
+  // RUs for the largest total metric
+  if (leaves.size () > 1)
+    {
+      std::vector<int> ruOfOwner;
+      m_ruSolver.Reset (leaves.size (), leaves.size ());
+      for (uint32_t o = 0; o < leaves.size (); o++)
+        {
+          for (uint32_t l = 0; l < leaves.size (); l++)
+            {
+              m_ruSolver.SetUtility (o, l, GetMetric (candidates[leaves[o].owner], leaves[l].type));
+            }
+        }
+      m_ruSolver.Solve (ruOfOwner);
+      std::vector<int> owners (leaves.size ());
+      for (uint32_t o = 0; o < leaves.size (); o++)
+        {
+          owners[ruOfOwner[o]] = leaves[o].owner;
+        }
+      for (uint32_t l = 0; l < leaves.size (); l++)
+        {
+          leaves[l].owner = owners[l];
+        }
+    }
+
+  for (std::vector<RuNode>::const_iterator it = leaves.begin (); it != leaves.end (); it++)
+    {
+      const Candidate &candidate = candidates[it->owner];
+      RUInfo ru;
+      ru.type = it->type;
+      ru.index = it->index;
+      HeRuAssignment assignment;
+      assignment.index = candidate.index;
+      assignment.ruBitMap = HEBitMap::GetBitMapFromRUInfo (ru) + it->segment;
+      assignment.mcs = candidate.mcs;
+      assignment.chanW = g_ruChannelWidth[it->type];
+      assignments.push_back (assignment);
+      NS_LOG_DEBUG ("AID " << candidate.aid << " RU type " << it->type << " index " << it->index
+                    << " segment " << it->segment << " MCS " << candidate.mcs);
+    }
+}
+
+int
+HePfScheduler::GetChildren (const RuNode &node, RuNode children[3])
+{
+  int count = 0;
+  for (int k = 0; k < 3; k++)
+    {
+      children[k].type = node.type - 1;
+      children[k].segment = node.segment;
+      children[k].owner = -1;
+    }
+  switch (node.type)
+    {
+    case 7:
+      // 2x996 tones: the 996 tone RU of each 80 Mhz segment
+      children[0].index = 0;
+      children[1].index = 0;
+      children[1].segment = 1;
+      count = 2;
+      break;
+    case 6:
+    case 5:
+      children[0].index = 2 * node.index;
+      children[1].index = 2 * node.index + 1;
+      count = 2;
+      break;
+    case 4:
+      {
+        // 242 tones: two 106 tone RUs around the center 26 tone RU
+        int first26 = 9 * node.index + (node.index >= 2 ? 1 : 0);
+        children[0].index = 2 * node.index;
+        children[1].index = 2 * node.index + 1;
+        children[2].type = 1;
+        children[2].index = first26 + 4;
+        count = 3;
+      }
+      break;
+    case 3:
+      children[0].index = 2 * node.index;
+      children[1].index = 2 * node.index + 1;
+      count = 2;
+      break;
+    case 2:
+      {
+        int first26 = 9 * (node.index / 4) + (node.index / 4 >= 2 ? 1 : 0);
+        children[0].index = first26 + g_ru26Of52[node.index % 4][0];
+        children[1].index = first26 + g_ru26Of52[node.index % 4][1];
+        count = 2;
+      }
+      break;
+    default:
+      break;
+    }
+  return count;
+}
+
+double
+HePfScheduler::GetServedBits (const Candidate &candidate, int ruType) const
+{
+  double capacity = HEBitMap::GetHeDataRate (ruType, candidate.mcs, 800, 1) * m_ppduDuration.GetSeconds ();
+  return std::min (capacity, candidate.demand);
+}
+
+double
+HePfScheduler::GetMetric (const Candidate &candidate, int ruType) const
+{
+  // A station never served yet is weighted as if it got 1 bit/s
+  return GetServedBits (candidate, ruType) / std::max (candidate.weight, 1.0) + candidate.bonus;
+}
+
+void
+HePfScheduler::UpdateAverages (std::vector<double> &averages, const HeStationSnapshotList &stations,
+                               const CandidateList &candidates, const HeRuAssignmentList &assignments)
+{
+  double alpha = 1.0 / m_timeConstant;
+  std::vector<bool> aged;
+
+  for (HeStationSnapshotList::const_iterator it = stations.begin (); it != stations.end (); it++)
+    {
+      if (it->aid >= averages.size ())
+        {
+          averages.resize (it->aid + 1, 0);
+        }
+    }
+  // A station has one entry per AC, age its average once
+  aged.assign (averages.size (), false);
+  for (HeStationSnapshotList::const_iterator it = stations.begin (); it != stations.end (); it++)
+    {
+      if (!aged[it->aid])
+        {
+          averages[it->aid] *= 1 - alpha;
+          aged[it->aid] = true;
+        }
+    }
+  for (HeRuAssignmentList::const_iterator it = assignments.begin (); it != assignments.end (); it++)
+    {
+      for (CandidateList::const_iterator c = candidates.begin (); c != candidates.end (); c++)
+        {
+          if (c->index == it->index)
+            {
+              double bits = GetServedBits (*c, HEBitMap::GetRUTypeFromChannelWidth (it->chanW));
+              averages[c->aid] += alpha * bits / m_ppduDuration.GetSeconds ();
+              break;
+            }
+        }
+    }
+}
+
+double
+HePfScheduler::GetAverage (const std::vector<double> &averages, uint16_t aid)
+{
+  return aid < averages.size () ? averages[aid] : 0;
+}
+
+int
+HePfScheduler::GetAcPriority (uint8_t ac)
+{
+  switch (ac)
+    {
+    case AC_VO:
+      return 3;
+    case AC_VI:
+      return 2;
+    case AC_BE:
+      return 1;
+    default:
+      return 0;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#ifndef HE_PF_SCHEDULER_H
+#define HE_PF_SCHEDULER_H
+
+#include "ns3/he-scheduler-plugin.h"
+#include "he-ru-assignment-solver.h"
+
+namespace ns3 {
+
+/**
+ * \brief Proportional fair HE MU scheduler with RU packing
+ *
+ * Each station is weighted by the bits it could send in the next PPDU,
+ * limited by its backlog, divided by its average throughput. The RU layout
+ * is grown from a single RU spanning the channel: an RU is split into its
+ * children (2x996 into 996, 996 into 484, 484 into 242, 242 into 106 + 26 +
+ * 106, 106 into 52, 52 into 26) as long as serving more stations on the
+ * smaller RUs increases the total weight. The RU rates come from
+ * HEBitMap::GetHeDataRate for the MCS selected by the rate control. Once
+ * the layout is settled, the stations are matched to its RUs by
+ * HeRuAssignmentSolver for the largest total weight.
+ *
+ * One RU is granted per station, to its highest priority access category
+ * with a backlog. The average throughput of every station present in a
+ * round is updated with an exponential moving average over TimeConstant
+ * rounds, when the round is committed.
+ */
+class HePfScheduler : public HeSchedulerPlugin
+{
+public:
+  static TypeId GetTypeId (void);
+
+  HePfScheduler ();
+  virtual ~HePfScheduler ();
+
+  virtual void ScheduleDownlink (const HeStationSnapshotList &stations,
+                                 HeRuAssignmentList &assignments);
+  virtual void ScheduleUplink (const HeStationSnapshotList &stations,
+                               HeRuAssignmentList &assignments);
+  virtual void CommitDownlink (const HeStationSnapshotList &stations,
+                               const HeRuAssignmentList &assignments);
+  virtual void CommitUplink (const HeStationSnapshotList &stations,
+                             const HeRuAssignmentList &assignments);
+
+protected:
+  /**
+   * Station competing for an RU in the current round
+   */
+  struct Candidate
+  {
+    uint32_t index;         //!< HeStationSnapshot::index of the served queue
+    uint32_t entry;         //!< Position of the served queue in the snapshot list
+    uint16_t aid;           //!< Association ID of the station
+    uint8_t ac;             //!< Access category of the served queue
+    uint32_t mcs;           //!< HE MCS
+    double demand;          //!< Bits waiting in the queue
+    double weight;          //!< Divider of the PF metric, average throughput in bit/s
+    double bonus;           //!< Added to the PF metric, 0 unless a subclass favors the candidate
+  };
+  typedef std::vector<Candidate> CandidateList;
+
+  /**
+   * Build one candidate per station with a backlog, for its highest priority AC
+   *
+   * \param stations the AP queues
+   * \param isDownlink select the DL or the reported UL backlog
+   * \param candidates the stations competing in the round
+   */
+  void SelectCandidates (const HeStationSnapshotList &stations, bool isDownlink,
+                         CandidateList &candidates);
+
+  /**
+   * Pack the candidates in RUs of the channel
+   *
+   * \param candidates the stations to serve, at most one per AID
+   * \param assignments the RUs of the next PPDU
+   */
+  void PackRus (const CandidateList &candidates, HeRuAssignmentList &assignments);
+  /**
+   * \return the bits the candidate can send in an RU of the given type in one PPDU
+   */
+  double GetServedBits (const Candidate &candidate, int ruType) const;
+  /**
+   * Age the average throughput of the stations of the round and credit
+   * the served ones
+   *
+   * \param averages the DL or UL averages, indexed by AID
+   * \param stations the stations of the round
+   * \param candidates the candidates of the round
+   * \param assignments the RUs granted to the candidates
+   */
+  void UpdateAverages (std::vector<double> &averages, const HeStationSnapshotList &stations,
+                       const CandidateList &candidates, const HeRuAssignmentList &assignments);
+  /**
+   * \return the average throughput of the station, or 0 if it was never seen
+   */
+  static double GetAverage (const std::vector<double> &averages, uint16_t aid);
+  /**
+   * \return the precedence of an access category, higher is served first
+   */
+  static int GetAcPriority (uint8_t ac);
+
+  uint32_t m_channelWidth;                //!< Channel width in Mhz
+  Time m_ppduDuration;                    //!< Duration of the HE MU PPDU
+  double m_timeConstant;                  //!< Averaging window in rounds
+  std::vector<double> m_averageDL;        //!< DL average throughput in bit/s, by AID
+  std::vector<double> m_averageUL;        //!< UL average throughput in bit/s, by AID
+  HeRuAssignmentSolver m_ruSolver;        //!< Matches the candidates to the packed RUs
+
+private:
+  /**
+   * Node of the RU tree
+   */
+  struct RuNode
+  {
+    int type;               //!< RU type, 1 (26 tones) to 7 (2x996 tones)
+    int index;              //!< RU index in its 80 Mhz segment
+    int segment;            //!< 80 Mhz segment of a 160 Mhz channel
+    int owner;              //!< Candidate served on the RU, -1 if none
+  };
+  /**
+   * \return the number of children of the RU, stored in children
+   */
+  static int GetChildren (const RuNode &node, RuNode children[3]);
+  /**
+   * \return the PF metric of the candidate on an RU of the given type
+   */
+  double GetMetric (const Candidate &candidate, int ruType) const;
+};
+
+} // namespace ns3
+
+#endif /* HE_PF_SCHEDULER_H */
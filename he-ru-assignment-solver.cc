@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#include <limits>
+#include "ns3/assert.h"
+#include "he-ru-assignment-solver.h"
+
+namespace ns3 {
+
+HeRuAssignmentSolver::HeRuAssignmentSolver ()
+  : m_nStations (0),
+    m_nRus (0)
+{
+}
+
+HeRuAssignmentSolver::~HeRuAssignmentSolver ()
+{
+}
+
+void
+HeRuAssignmentSolver::Reset (uint32_t nStations, uint32_t nRus)
+{
+  m_nStations = nStations;
+  m_nRus = nRus;
+  m_utility.assign (nStations * nRus, 0);
+}
+
+void
+HeRuAssignmentSolver::SetUtility (uint32_t station, uint32_t ru, double utility)
+{
+  NS_ASSERT (station < m_nStations && ru < m_nRus);
+  m_utility[station * m_nRus + ru] = utility;
+}
+
+double
+HeRuAssignmentSolver::GetUtility (uint32_t station, uint32_t ru) const
+{
+  NS_ASSERT (station < m_nStations && ru < m_nRus);
+  return m_utility[station * m_nRus + ru];
+}
+
+double
+HeRuAssignmentSolver::Solve (std::vector<int> &ruOfStation)
+{
+  const double infinity = std::numeric_limits<double>::infinity ();
+  // The algorithm assigns every row to a column: the smaller side is
+  // taken as the rows and the cost of a pair is its negated utility
+  bool transposed = m_nStations > m_nRus;
+  uint32_t nRows = transposed ? m_nRus : m_nStations;
+  uint32_t nColumns = transposed ? m_nStations : m_nRus;
+  double total = 0;
+
+  ruOfStation.assign (m_nStations, -1);
+  if (nRows == 0)
+    {
+      return 0;
+    }
+  m_rowPotential.assign (nRows + 1, 0);
+  m_columnPotential.assign (nColumns + 1, 0);
+  m_rowOfColumn.assign (nColumns + 1, 0);
+  m_previousColumn.assign (nColumns + 1, 0);
+  for (uint32_t row = 1; row <= nRows; row++)
+    {
+      // Grow a shortest augmenting path from the row to a free column
+      uint32_t column = 0;
+      m_rowOfColumn[0] = row;
+      m_minSlack.assign (nColumns + 1, infinity);
+      m_visited.assign (nColumns + 1, false);
+      do
+        {
+          m_visited[column] = true;
+          uint32_t pathRow = m_rowOfColumn[column];
+          uint32_t nextColumn = 0;
+          double delta = infinity;
+          for (uint32_t j = 1; j <= nColumns; j++)
+            {
+              if (m_visited[j])
+                {
+                  continue;
+                }
+              double utility = transposed ? m_utility[(j - 1) * m_nRus + pathRow - 1]
+                                          : m_utility[(pathRow - 1) * m_nRus + j - 1];
+              double slack = -utility - m_rowPotential[pathRow] - m_columnPotential[j];
+              if (slack < m_minSlack[j])
+                {
+                  m_minSlack[j] = slack;
+                  m_previousColumn[j] = column;
+                }
+              if (m_minSlack[j] < delta)
+                {
+                  delta = m_minSlack[j];
+                  nextColumn = j;
+                }
+            }
+          for (uint32_t j = 0; j <= nColumns; j++)
+            {
+              if (m_visited[j])
+                {
+                  m_rowPotential[m_rowOfColumn[j]] += delta;
+                  m_columnPotential[j] -= delta;
+                }
+              else
+                {
+                  m_minSlack[j] -= delta;
+                }
+            }
+          column = nextColumn;
+        }
+      while (m_rowOfColumn[column] != 0);
+      // Flip the path
+      do
+        {
+          uint32_t previous = m_previousColumn[column];
+          m_rowOfColumn[column] = m_rowOfColumn[previous];
+          column = previous;
+        }
+      while (column != 0);
+    }
+
+  for (uint32_t j = 1; j <= nColumns; j++)
+    {
+      uint32_t row = m_rowOfColumn[j];
+      if (row == 0)
+        {
+          continue;
+        }
+      uint32_t station = transposed ? j - 1 : row - 1;
+      uint32_t ru = transposed ? row - 1 : j - 1;
+      ruOfStation[station] = ru;
+      total += m_utility[station * m_nRus + ru];
+    }
+  return total;
+}
+
+} // namespace ns3
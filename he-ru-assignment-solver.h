@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#ifndef HE_RU_ASSIGNMENT_SOLVER_H
+#define HE_RU_ASSIGNMENT_SOLVER_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Maximum utility assignment of stations to the RUs of an HE MU PPDU
+ *
+ * Once the RU layout of a PPDU is chosen, granting the RUs to the stations
+ * is a bipartite assignment problem. The solver is given the utility of
+ * each station on each RU, e.g. the bits it can send there at the MCS its
+ * SNR supports, and finds the one to one assignment with the largest total
+ * utility with the Hungarian algorithm, in O(n^3) for n = max(stations,
+ * RUs), that is at most HE_MAX_RU_COUNT in a PPDU. With more stations than
+ * RUs, some stations are left out, and conversely.
+ *
+ * The workspace is kept from one call to the next, so that a solver owned
+ * by a scheduler does not allocate once it has seen its largest round.
+ */
+class HeRuAssignmentSolver
+{
+public:
+  HeRuAssignmentSolver ();
+  ~HeRuAssignmentSolver ();
+
+  /**
+   * Start a new problem, all utilities being 0
+   *
+   * \param nStations number of stations
+   * \param nRus number of RUs
+   */
+  void Reset (uint32_t nStations, uint32_t nRus);
+  /**
+   * \param station station index, below nStations
+   * \param ru RU index, below nRus
+   * \param utility value of granting the RU to the station
+   */
+  void SetUtility (uint32_t station, uint32_t ru, double utility);
+  /**
+   * \return the utility of the RU for the station
+   */
+  double GetUtility (uint32_t station, uint32_t ru) const;
+  /**
+   * \param ruOfStation the RU granted to each station, -1 for the
+   *        stations left out
+   * \return the total utility of the assignment
+   */
+  double Solve (std::vector<int> &ruOfStation);
+
+private:
+  uint32_t m_nStations;             //!< Stations of the current problem
+  uint32_t m_nRus;                  //!< RUs of the current problem
+  std::vector<double> m_utility;    //!< Utilities, m_nRus per station
+  // Hungarian algorithm workspace, indexed from 1 with 0 as the sentinel
+  std::vector<double> m_rowPotential;
+  std::vector<double> m_columnPotential;
+  std::vector<double> m_minSlack;
+  std::vector<uint32_t> m_rowOfColumn;
+  std::vector<uint32_t> m_previousColumn;
+  std::vector<bool> m_visited;
+};
+
+} // namespace ns3
+
+#endif /* HE_RU_ASSIGNMENT_SOLVER_H */
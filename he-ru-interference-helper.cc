@@ -0,0 +1,307 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#include <algorithm>
+#include <functional>
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/he-bitmap.h"
+#include "wifi-phy.h"
+#include "he-ru-interference-helper.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("HeRuInterferenceHelper");
+
+/* Subcarrier spacing of HE PPDUs in Hz */
+static const double g_heSubcarrierSpacing = 78125;
+
+/* Tones of an RU by RU type */
+static const uint32_t g_ruTones[8] = {0, 26, 52, 106, 242, 484, 996, 1992};
+
+/* First 26 tone block covered by each 52 tone RU of a 20 Mhz channel,
+ * the center 26 tone RU (block 4) being left out */
+static const uint32_t g_first26Of52[4] = {0, 2, 5, 7};
+
+HeRuInterferenceHelper::HeRuInterferenceHelper ()
+  : m_nextId (0),
+    m_noiseFigure (0)
+{
+}
+
+HeRuInterferenceHelper::~HeRuInterferenceHelper ()
+{
+  EraseEvents ();
+  m_errorRateModel = 0;
+}
+
+void
+HeRuInterferenceHelper::SetNoiseFigure (double value)
+{
+  m_noiseFigure = value;
+}
+
+void
+HeRuInterferenceHelper::SetErrorRateModel (Ptr<ErrorRateModel> rate)
+{
+  m_errorRateModel = rate;
+}
+
+void
+HeRuInterferenceHelper::SetBlocks (uint8_t ruBitMap, uint32_t channelWidth, Signal &signal)
+{
+  RUInfo ru = HEBitMap::GetRUInfoFromTriggerBitMap (ruBitMap);
+  uint32_t first = 0;
+  uint32_t count;
+
+  if (ruBitMap == 0xff || ru.type == 0)
+    {
+      // Whole channel: 9 blocks per 20 Mhz, plus the center one of an 80 Mhz segment
+      count = (channelWidth >= 160) ? 74 : (channelWidth >= 80) ? 37 : 9 * std::max<uint32_t> (channelWidth, 20) / 20;
+      signal.bandwidth = channelWidth * 1e6;
+    }
+  else
+    {
+      // 20 Mhz channel of the RU, for the 52 to 242 tone RUs. The blocks
+      // of the upper 40 Mhz of a segment follow its center block.
+      uint32_t ruPer20 = (ru.type == 2) ? 4 : (ru.type == 3) ? 2 : 1;
+      uint32_t index20 = ru.index / ruPer20;
+      uint32_t first20 = 9 * index20 + (index20 >= 2 ? 1 : 0);
+      switch (ru.type)
+        {
+        case 1:
+          first = ru.index;
+          count = 1;
+          break;
+        case 2:
+          first = first20 + g_first26Of52[ru.index % 4];
+          count = 2;
+          break;
+        case 3:
+          first = first20 + (ru.index % 2) * 5;
+          count = 4;
+          break;
+        case 4:
+          first = first20;
+          count = 9;
+          break;
+        case 5:
+          first = 19 * ru.index;
+          count = 18;
+          break;
+        case 6:
+          count = 37;
+          break;
+        default:
+          count = 74;
+          break;
+        }
+      if (ru.type < 7 && (ruBitMap & 1))
+        {
+          first += 37;
+        }
+      signal.bandwidth = g_ruTones[ru.type] * g_heSubcarrierSpacing;
+    }
+  NS_ASSERT (first + count <= 128);
+  signal.blocks[0] = 0;
+  signal.blocks[1] = 0;
+  for (uint32_t k = first; k < first + count; k++)
+    {
+      signal.blocks[k / 64] |= (uint64_t)1 << (k % 64);
+    }
+  signal.nBlocks = count;
+}
+
+double
+HeRuInterferenceHelper::GetSharedPower (const Signal &source, const Signal &victim)
+{
+  uint32_t overlap = __builtin_popcountll (source.blocks[0] & victim.blocks[0])
+    + __builtin_popcountll (source.blocks[1] & victim.blocks[1]);
+  return source.event->GetRxPowerW () * overlap / source.nBlocks;
+}
+
+HeRuInterferenceHelper::Signal *
+HeRuInterferenceHelper::Find (uint64_t id)
+{
+  std::vector<Signal>::iterator it = std::lower_bound (m_signals.begin (), m_signals.end (), id,
+                                                       [] (const Signal &signal, uint64_t key)
+                                                       { return signal.id < key; });
+  if (it == m_signals.end () || it->id != id)
+    {
+      return 0;
+    }
+  return &(*it);
+}
+
+double
+HeRuInterferenceHelper::CalculateChunkSuccessRate (double snir, Time duration, WifiMode mode, WifiTxVector txVector) const
+{
+  if (duration.IsZero ())
+    {
+      return 1.0;
+    }
+  uint64_t rate = mode.GetDataRate (txVector);
+  uint64_t nbits = (uint64_t)(rate * duration.GetSeconds ());
+  return m_errorRateModel->GetChunkSuccessRate (mode, txVector, snir, (uint32_t)nbits);
+}
+
+double
+HeRuInterferenceHelper::CalculateSnir (const Signal &signal) const
+{
+  static const double BOLTZMANN = 1.3803e-23;
+  double noise = m_noiseFigure * BOLTZMANN * 290.0 * signal.bandwidth;
+  return signal.event->GetRxPowerW () / (noise + std::max (signal.interference, 0.0));
+}
+
+void
+HeRuInterferenceHelper::Integrate (Signal &signal, Time until) const
+{
+  Time from = std::max (signal.integrated, signal.payloadStart);
+
+  until = std::min (until, signal.event->GetEndTime ());
+  if (until <= from)
+    {
+      return;
+    }
+  double snir = CalculateSnir (signal);
+  if (signal.snr < 0)
+    {
+      signal.snr = snir;
+    }
+  signal.psr *= CalculateChunkSuccessRate (snir, until - from, signal.event->GetPayloadMode (),
+                                           signal.event->GetTxVector ());
+  signal.integrated = until;
+}
+
+void
+HeRuInterferenceHelper::ApplyEnds (Time until)
+{
+  std::greater<std::pair<Time, uint64_t> > later;
+
+  while (!m_ends.empty () && m_ends.front ().first <= until)
+    {
+      Time end = m_ends.front ().first;
+      Signal *ended = Find (m_ends.front ().second);
+      std::pop_heap (m_ends.begin (), m_ends.end (), later);
+      m_ends.pop_back ();
+      if (ended == 0)
+        {
+          continue;
+        }
+      // Close the chunk of the signals still on the air that it overlapped
+      for (std::vector<Signal>::iterator it = m_signals.begin (); it != m_signals.end (); it++)
+        {
+          if (it->id == ended->id || it->event->GetEndTime () <= end || it->event->GetStartTime () >= end)
+            {
+              continue;
+            }
+          double power = GetSharedPower (*ended, *it);
+          if (power > 0)
+            {
+              Integrate (*it, end);
+              it->interference -= power;
+            }
+        }
+    }
+}
+
+void
+HeRuInterferenceHelper::Add (Ptr<InterferenceHelper::Event> event, uint32_t channelWidth)
+{
+  NS_LOG_FUNCTION (this << event << channelWidth);
+  NS_ASSERT_MSG (m_errorRateModel != 0, "Error rate model not set");
+  Time now = Simulator::Now ();
+
+  ApplyEnds (now);
+  // The ends of the older signals have been applied, the signals ended
+  // before now are not needed by any reception any more
+  std::vector<Signal>::iterator end = m_signals.begin ();
+  for (std::vector<Signal>::iterator it = m_signals.begin (); it != m_signals.end (); it++)
+    {
+      if (it->event->GetEndTime () >= now)
+        {
+          *end++ = *it;
+        }
+    }
+  m_signals.erase (end, m_signals.end ());
+
+  Signal signal;
+  signal.id = m_nextId++;
+  signal.event = event;
+  SetBlocks (event->GetTxVector ().GetRu (), channelWidth, signal);
+  signal.payloadStart = event->GetStartTime ()
+    + WifiPhy::CalculatePlcpPreambleAndHeaderDuration (event->GetTxVector (), event->GetPreambleType ());
+  signal.integrated = signal.payloadStart;
+  signal.interference = 0;
+  signal.psr = 1.0;
+  signal.snr = -1;
+  // Close the current chunk of the overlapped signals, and start ours
+  // with the power of the signals on the air
+  for (std::vector<Signal>::iterator it = m_signals.begin (); it != m_signals.end (); it++)
+    {
+      if (it->event->GetEndTime () <= now)
+        {
+          continue;
+        }
+      double power = GetSharedPower (signal, *it);
+      if (power > 0)
+        {
+          Integrate (*it, now);
+          it->interference += power;
+          signal.interference += GetSharedPower (*it, signal);
+        }
+    }
+  m_signals.push_back (signal);
+  m_ends.push_back (std::make_pair (event->GetEndTime (), signal.id));
+  std::push_heap (m_ends.begin (), m_ends.end (), std::greater<std::pair<Time, uint64_t> > ());
+}
+
+struct InterferenceHelper::SnrPer
+HeRuInterferenceHelper::CalculatePlcpPayloadSnrPer (Ptr<InterferenceHelper::Event> event)
+{
+  NS_LOG_FUNCTION (this << event);
+  struct InterferenceHelper::SnrPer snrPer;
+  Signal *signal = 0;
+
+  ApplyEnds (event->GetEndTime ());
+  for (std::vector<Signal>::reverse_iterator it = m_signals.rbegin (); it != m_signals.rend (); it++)
+    {
+      if (it->event == event)
+        {
+          signal = &(*it);
+          break;
+        }
+    }
+  NS_ASSERT_MSG (signal != 0, "Signal not added");
+  Integrate (*signal, event->GetEndTime ());
+  // Without payload, the SNR is the one at the end of the signal
+  snrPer.snr = (signal->snr < 0) ? CalculateSnir (*signal) : signal->snr;
+  snrPer.per = 1 - signal->psr;
+  return snrPer;
+}
+
+void
+HeRuInterferenceHelper::EraseEvents (void)
+{
+  m_signals.clear ();
+  m_ends.clear ();
+}
+
+} //namespace ns3
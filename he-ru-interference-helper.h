@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#ifndef HE_RU_INTERFERENCE_HELPER_H
+#define HE_RU_INTERFERENCE_HELPER_H
+
+#include <stdint.h>
+#include <vector>
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "interference-helper.h"
+#include "error-rate-model.h"
+
+namespace ns3 {
+
+/**
+ * \brief Interference resolved on the 26 tone blocks of an HE channel
+ *
+ * InterferenceHelper sums the power of all the signals over the whole
+ * channel, so the TB PPDUs that the stations of an UL MU transmission send
+ * at the same time on disjoint RUs interfere with each other. This helper
+ * records the 26 tone blocks occupied by each signal, spreads its power
+ * evenly over them, and computes the SNR and PER of a reception from the
+ * energy falling on its own blocks only. Signals on disjoint RUs are
+ * skipped without being integrated.
+ *
+ * A signal not sent on an RU (RU 0xff) occupies every block of the
+ * channel. Blocks follow the 26 tone RU numbering of an 80 Mhz segment,
+ * the second segment of a 160 Mhz channel coming after the first one.
+ *
+ * The payload success rate of every signal is integrated as the signals
+ * come and go rather than from the whole signal list at the end of each
+ * reception: a signal arriving or ending closes the current chunk of the
+ * signals it overlaps, whose interference is then updated. The ends of
+ * the signals are kept in a time sorted heap and applied before any later
+ * arrival or result, so that the work per reception grows with the
+ * signals overlapping it instead of with all the signals of the period.
+ * The error rate model and noise figure must be set before the first Add.
+ */
+class HeRuInterferenceHelper
+{
+public:
+  HeRuInterferenceHelper ();
+  ~HeRuInterferenceHelper ();
+
+  /**
+   * \param value noise figure, as a ratio
+   */
+  void SetNoiseFigure (double value);
+  /**
+   * \param rate the error rate model used to compute the PER of the chunks
+   */
+  void SetErrorRateModel (Ptr<ErrorRateModel> rate);
+  /**
+   * Record a signal arriving at the PHY
+   *
+   * \param event the signal, as added to the InterferenceHelper
+   * \param channelWidth width in Mhz of the channel of the PHY
+   */
+  void Add (Ptr<InterferenceHelper::Event> event, uint32_t channelWidth);
+  /**
+   * \param event a signal previously added, ending now
+   * \return the SNR at the start of the payload and the PER of the
+   *         payload, counting the signals overlapping the RU of the event only
+   */
+  struct InterferenceHelper::SnrPer CalculatePlcpPayloadSnrPer (Ptr<InterferenceHelper::Event> event);
+  /**
+   * Forget every signal, e.g. on a channel switch
+   */
+  void EraseEvents (void);
+
+private:
+  /**
+   * Signal recorded by Add, with the state of the integration of its payload
+   */
+  struct Signal
+  {
+    uint64_t id;                          //!< Arrival order, key of the signal in m_ends
+    Ptr<InterferenceHelper::Event> event; //!< Power, duration and TXVECTOR of the signal
+    uint64_t blocks[2];                   //!< Occupied 26 tone blocks, block k at bit k % 64 of blocks[k / 64]
+    uint32_t nBlocks;                     //!< Number of occupied blocks
+    double bandwidth;                     //!< Bandwidth of the signal in Hz
+    Time payloadStart;                    //!< Start of the payload of the signal
+    Time integrated;                      //!< End of the part of the payload already integrated
+    double interference;                  //!< Power in W of the other signals on our blocks
+    double psr;                           //!< Success rate of the integrated part of the payload
+    double snr;                           //!< SNR at the start of the payload, -1 until known
+  };
+  /**
+   * Fill the blocks, nBlocks and bandwidth of a signal
+   *
+   * \param ruBitMap trigger frame bitmap of the RU, 0xff for the whole channel
+   * \param channelWidth width in Mhz of the channel of the PHY
+   * \param signal the signal to fill
+   */
+  static void SetBlocks (uint8_t ruBitMap, uint32_t channelWidth, Signal &signal);
+  /**
+   * \return the power in W that the source puts on the blocks of the victim
+   */
+  static double GetSharedPower (const Signal &source, const Signal &victim);
+  /**
+   * \return the current signal to noise plus interference ratio of a signal
+   */
+  double CalculateSnir (const Signal &signal) const;
+  /**
+   * Integrate the payload of a signal up to the given time at its current interference
+   */
+  void Integrate (Signal &signal, Time until) const;
+  /**
+   * Apply the ends of the signals up to the given time, included
+   */
+  void ApplyEnds (Time until);
+  /**
+   * \return the signal with the given id, 0 if it was pruned
+   */
+  Signal *Find (uint64_t id);
+  /**
+   * \return the probability that a chunk of the payload is received
+   */
+  double CalculateChunkSuccessRate (double snir, Time duration, WifiMode mode, WifiTxVector txVector) const;
+
+  std::vector<Signal> m_signals;          //!< Signals that may still overlap a reception, by id
+  std::vector<std::pair<Time, uint64_t> > m_ends; //!< Min heap of the end times of the signals, with their id
+  uint64_t m_nextId;                      //!< Id of the next signal
+  Ptr<ErrorRateModel> m_errorRateModel;   //!< Error rate model
+  double m_noiseFigure;                   //!< Noise figure, as a ratio
+};
+
+} //namespace ns3
+
+#endif /* HE_RU_INTERFERENCE_HELPER_H */
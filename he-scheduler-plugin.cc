@@ -0,0 +1,64 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#include "ns3/log.h"
+#include "he-scheduler-plugin.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("HeSchedulerPlugin");
+
+NS_OBJECT_ENSURE_REGISTERED (HeSchedulerPlugin);
+
+TypeId
+HeSchedulerPlugin::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::HeSchedulerPlugin")
+    .SetParent<Object> ()
+    .SetGroupName ("Wifi")
+  ;
+  return tid;
+}
+
+HeSchedulerPlugin::HeSchedulerPlugin ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+HeSchedulerPlugin::~HeSchedulerPlugin ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+HeSchedulerPlugin::CommitDownlink (const HeStationSnapshotList &stations,
+                                   const HeRuAssignmentList &assignments)
+{
+  NS_LOG_FUNCTION (this << assignments.size ());
+}
+
+void
+HeSchedulerPlugin::CommitUplink (const HeStationSnapshotList &stations,
+                                 const HeRuAssignmentList &assignments)
+{
+  NS_LOG_FUNCTION (this << assignments.size ());
+}
+
+} // namespace ns3
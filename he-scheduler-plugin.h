@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#ifndef HE_SCHEDULER_PLUGIN_H
+#define HE_SCHEDULER_PLUGIN_H
+
+#include <stdint.h>
+#include <vector>
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/mac48-address.h"
+
+namespace ns3 {
+
+/**
+ * State of one (station, access category) queue of the AP, as seen by a
+ * scheduler at the start of a scheduling round.
+ */
+struct HeStationSnapshot
+{
+  uint32_t index;           //!< Station index in the RRM manager, to be returned in HeRuAssignment
+  uint16_t aid;             //!< Association ID of the station
+  Mac48Address address;     //!< MAC address of the station
+  uint8_t ac;               //!< Access category of the queue
+  bool needsAccess;         //!< The DL queue has a packet to send
+  uint32_t bufferDepthDL;   //!< DL queue depth in bytes
+  Time waitingTimeDL;       //!< Time spent in the DL queue by its head of line packet
+  double throughputDL;      //!< DL queue throughput
+  uint32_t bufferDepthUL;   //!< Last buffer status reported by the station in bytes, 0xffffffff if unknown or stale
+  Time waitingTimeUL;       //!< Time since the last UL buffer status report
+  uint32_t mcs;             //!< MCS selected by the rate control, 0 if unknown
+};
+
+typedef std::vector<HeStationSnapshot> HeStationSnapshotList;
+
+/**
+ * RU and MCS granted to one station for the next HE MU PPDU.
+ */
+struct HeRuAssignment
+{
+  uint32_t index;           //!< HeStationSnapshot::index of the served station
+  uint8_t ruBitMap;         //!< Trigger frame bitmap of the RU, see HEBitMap
+  uint8_t mcs;              //!< HE MCS
+  uint8_t chanW;            //!< RU width in Mhz (2, 4, 8, 20, 40, 80 or 160)
+};
+
+typedef std::vector<HeRuAssignment> HeRuAssignmentList;
+
+/**
+ * \brief In-process scheduler for RRMWifiManager
+ *
+ * A scheduler plugin receives a read-only snapshot of the AP queues each
+ * time the AP gains access to the medium and returns the RU and MCS
+ * assignments of the next DL or UL HE MU PPDU. It runs at function call
+ * latency, as opposed to the external RRM server reached over TCP.
+ *
+ * Scheduling is split in two steps. ScheduleDownlink and ScheduleUplink
+ * only plan a PPDU and must leave the plugin state unchanged: the same
+ * snapshot gives the same assignments, and the caller may plan several
+ * PPDUs ahead and discard them. CommitDownlink and CommitUplink are called
+ * with the snapshot and the assignments of the PPDU actually sent, and are
+ * the only place where a plugin updates its history (average throughputs,
+ * poll times, counters).
+ *
+ * Plugins are ns-3 Objects: a subclass registered with a TypeId is
+ * selected by setting the RRMWifiManager SchedulerPluginType attribute to
+ * its TypeId name, together with the SchedulerPlugin attribute. Rate
+ * estimates for an assignment can be obtained with HEBitMap::GetHeDataRate.
+ */
+class HeSchedulerPlugin : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  HeSchedulerPlugin ();
+  virtual ~HeSchedulerPlugin ();
+
+  /**
+   * \param stations the AP queues
+   * \param assignments the RUs to use for the next DL HE MU PPDU, empty
+   *        if no station is to be served
+   */
+  virtual void ScheduleDownlink (const HeStationSnapshotList &stations,
+                                 HeRuAssignmentList &assignments) = 0;
+  /**
+   * \param stations the AP queues
+   * \param assignments the RUs to trigger for the next UL HE MU PPDU,
+   *        empty if no station is to be triggered
+   */
+  virtual void ScheduleUplink (const HeStationSnapshotList &stations,
+                               HeRuAssignmentList &assignments) = 0;
+  /**
+   * Record that a DL HE MU PPDU was sent, does nothing by default
+   *
+   * \param stations the AP queues the PPDU was planned from
+   * \param assignments the RUs of the PPDU, a subset of those planned
+   */
+  virtual void CommitDownlink (const HeStationSnapshotList &stations,
+                               const HeRuAssignmentList &assignments);
+  /**
+   * Record that stations were triggered for an UL HE MU PPDU, does nothing
+   * by default
+   *
+   * \param stations the AP queues the PPDU was planned from
+   * \param assignments the RUs of the PPDU
+   */
+  virtual void CommitUplink (const HeStationSnapshotList &stations,
+                             const HeRuAssignmentList &assignments);
+};
+
+} // namespace ns3
+
+#endif /* HE_SCHEDULER_PLUGIN_H */
@@ -0,0 +1,266 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+#include "he-traffic-model.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("HeTrafficModel");
+
+NS_OBJECT_ENSURE_REGISTERED (HeTrafficModel);
+NS_OBJECT_ENSURE_REGISTERED (HeVoipTrafficModel);
+NS_OBJECT_ENSURE_REGISTERED (HeVideoTrafficModel);
+NS_OBJECT_ENSURE_REGISTERED (HeFullBufferTrafficModel);
+
+TypeId
+HeTrafficModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::HeTrafficModel")
+    .SetParent<Object> ()
+    .SetGroupName ("Wifi")
+  ;
+  return tid;
+}
+
+HeTrafficModel::HeTrafficModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+HeTrafficModel::~HeTrafficModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+HeVoipTrafficModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::HeVoipTrafficModel")
+    .SetParent<HeTrafficModel> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<HeVoipTrafficModel> ()
+    .AddAttribute ("PacketSize",
+                   "Size of the voice packets in bytes",
+                   UintegerValue (38),
+                   MakeUintegerAccessor (&HeVoipTrafficModel::m_packetSize),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("TalkInterval",
+                   "Interval between the packets of a talk spurt",
+                   TimeValue (MilliSeconds (20)),
+                   MakeTimeAccessor (&HeVoipTrafficModel::m_talkInterval),
+                   MakeTimeChecker ())
+    .AddAttribute ("SilenceInterval",
+                   "Interval between the last packet of a talk spurt and the first packet of the next one",
+                   TimeValue (MilliSeconds (160)),
+                   MakeTimeAccessor (&HeVoipTrafficModel::m_silenceInterval),
+                   MakeTimeChecker ())
+    .AddAttribute ("MinTalkPackets",
+                   "Lower bound of the number of packets of a talk spurt",
+                   UintegerValue (8),
+                   MakeUintegerAccessor (&HeVoipTrafficModel::m_minTalkPackets),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("MaxTalkPackets",
+                   "Upper bound of the number of packets of a talk spurt",
+                   UintegerValue (12),
+                   MakeUintegerAccessor (&HeVoipTrafficModel::m_maxTalkPackets),
+                   MakeUintegerChecker<uint32_t> ())
+  ;
+  return tid;
+}
+
+HeVoipTrafficModel::HeVoipTrafficModel ()
+  : m_talkPackets (0)
+{
+  NS_LOG_FUNCTION (this);
+  m_spurtLength = CreateObject<UniformRandomVariable> ();
+}
+
+HeVoipTrafficModel::~HeVoipTrafficModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint32_t
+HeVoipTrafficModel::GetNextFrameSize (void)
+{
+  return m_packetSize;
+}
+
+Time
+HeVoipTrafficModel::GetNextFrameInterval (void)
+{
+  if (m_talkPackets)
+    {
+      m_talkPackets--;
+      return m_talkInterval;
+    }
+  m_talkPackets = m_spurtLength->GetValue (m_minTalkPackets, m_maxTalkPackets);
+  return m_silenceInterval;
+}
+
+int64_t
+HeVoipTrafficModel::AssignStreams (int64_t stream)
+{
+  m_spurtLength->SetStream (stream);
+  return 1;
+}
+
+TypeId
+HeVideoTrafficModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::HeVideoTrafficModel")
+    .SetParent<HeTrafficModel> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<HeVideoTrafficModel> ()
+    .AddAttribute ("VideoClass",
+                   "Video class, from 1 to 6, setting the scale of the frame size distribution",
+                   UintegerValue (2),
+                   MakeUintegerAccessor (&HeVideoTrafficModel::m_videoClass),
+                   MakeUintegerChecker<uint8_t> (1, 6))
+    .AddAttribute ("MinFrameSize",
+                   "Smallest frame in bytes, also the size of the first frame",
+                   UintegerValue (150),
+                   MakeUintegerAccessor (&HeVideoTrafficModel::m_minFrameSize),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("MinFrameInterval",
+                   "Fixed part of the frame interval",
+                   TimeValue (MilliSeconds (35)),
+                   MakeTimeAccessor (&HeVideoTrafficModel::m_minFrameInterval),
+                   MakeTimeChecker ())
+    .AddAttribute ("IntervalAlpha",
+                   "Shape of the Gamma distribution of the variable part of the frame interval",
+                   DoubleValue (0.2463),
+                   MakeDoubleAccessor (&HeVideoTrafficModel::m_intervalAlpha),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("IntervalBeta",
+                   "Scale in seconds of the Gamma distribution of the variable part of the frame interval",
+                   DoubleValue (1 / 60.227),
+                   MakeDoubleAccessor (&HeVideoTrafficModel::m_intervalBeta),
+                   MakeDoubleChecker<double> (0))
+  ;
+  return tid;
+}
+
+HeVideoTrafficModel::HeVideoTrafficModel ()
+  : m_firstFrame (true)
+{
+  NS_LOG_FUNCTION (this);
+  m_frameSize = CreateObject<WeibullRandomVariable> ();
+  m_frameInterval = CreateObject<GammaRandomVariable> ();
+}
+
+HeVideoTrafficModel::~HeVideoTrafficModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+HeVideoTrafficModel::GetWeibullParameters (uint8_t videoClass, double &scale, double &shape)
+{
+  static const double scales[] = {6950, 13900, 20850, 27800, 34750, 54210};
+  NS_ASSERT (videoClass >= 1 && videoClass <= 6);
+  scale = scales[videoClass - 1];
+  shape = 0.8099;
+}
+
+uint32_t
+HeVideoTrafficModel::GetNextFrameSize (void)
+{
+  double scale;
+  double shape;
+  GetWeibullParameters (m_videoClass, scale, shape);
+  uint32_t size = m_frameSize->GetValue (scale, shape, 0);
+  if (m_firstFrame || size < m_minFrameSize)
+    {
+      size = m_minFrameSize;
+    }
+  m_firstFrame = false;
+  return size;
+}
+
+Time
+HeVideoTrafficModel::GetNextFrameInterval (void)
+{
+  return m_minFrameInterval + Seconds (m_frameInterval->GetValue (m_intervalAlpha, m_intervalBeta));
+}
+
+int64_t
+HeVideoTrafficModel::AssignStreams (int64_t stream)
+{
+  m_frameSize->SetStream (stream);
+  m_frameInterval->SetStream (stream + 1);
+  return 2;
+}
+
+TypeId
+HeFullBufferTrafficModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::HeFullBufferTrafficModel")
+    .SetParent<HeTrafficModel> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<HeFullBufferTrafficModel> ()
+    .AddAttribute ("PacketSize",
+                   "Size of the packets in bytes",
+                   UintegerValue (200),
+                   MakeUintegerAccessor (&HeFullBufferTrafficModel::m_packetSize),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("Interval",
+                   "Interval between two packets",
+                   TimeValue (MicroSeconds (8)),
+                   MakeTimeAccessor (&HeFullBufferTrafficModel::m_interval),
+                   MakeTimeChecker ())
+  ;
+  return tid;
+}
+
+HeFullBufferTrafficModel::HeFullBufferTrafficModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+HeFullBufferTrafficModel::~HeFullBufferTrafficModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint32_t
+HeFullBufferTrafficModel::GetNextFrameSize (void)
+{
+  return m_packetSize;
+}
+
+Time
+HeFullBufferTrafficModel::GetNextFrameInterval (void)
+{
+  return m_interval;
+}
+
+int64_t
+HeFullBufferTrafficModel::AssignStreams (int64_t stream)
+{
+  return 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+
+#ifndef HE_TRAFFIC_MODEL_H
+#define HE_TRAFFIC_MODEL_H
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/random-variable-stream.h"
+
+namespace ns3 {
+
+/**
+ * \brief Arrival and size model of the frames of an HeTrafficSource
+ *
+ * The source asks the model for the size of each frame it sends, then for
+ * the time to the next frame. A frame larger than the fragment size of the
+ * source is sent as several packets.
+ */
+class HeTrafficModel : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  HeTrafficModel ();
+  virtual ~HeTrafficModel ();
+
+  /**
+   * \return the size in bytes of the next frame
+   */
+  virtual uint32_t GetNextFrameSize (void) = 0;
+  /**
+   * \return the time between the frame just sent and the next one
+   */
+  virtual Time GetNextFrameInterval (void) = 0;
+  /**
+   * Assign fixed random variable streams to the random variables of the model
+   *
+   * \param stream first stream index to use
+   * \return the number of stream indices assigned
+   */
+  virtual int64_t AssignStreams (int64_t stream) = 0;
+};
+
+/**
+ * \brief Voice over IP with talk spurts and silences
+ *
+ * Fixed size packets are sent every TalkInterval during a talk spurt of
+ * MinTalkPackets to MaxTalkPackets packets, then after a SilenceInterval.
+ */
+class HeVoipTrafficModel : public HeTrafficModel
+{
+public:
+  static TypeId GetTypeId (void);
+
+  HeVoipTrafficModel ();
+  virtual ~HeVoipTrafficModel ();
+
+  virtual uint32_t GetNextFrameSize (void);
+  virtual Time GetNextFrameInterval (void);
+  virtual int64_t AssignStreams (int64_t stream);
+
+private:
+  uint32_t m_packetSize;                    //!< Voice packet size in bytes
+  Time m_talkInterval;                      //!< Packet interval during a talk spurt
+  Time m_silenceInterval;                   //!< Silence between two talk spurts
+  uint32_t m_minTalkPackets;                //!< Smallest talk spurt
+  uint32_t m_maxTalkPackets;                //!< Largest talk spurt
+  uint32_t m_talkPackets;                   //!< Packets left in the current talk spurt
+  Ptr<UniformRandomVariable> m_spurtLength; //!< Draws the talk spurt lengths
+};
+
+/**
+ * \brief Video frames of Weibull distributed size
+ *
+ * The frame sizes follow a Weibull distribution whose scale is set by the
+ * video class, from 1 (6950 bytes) to 6 (54210 bytes), and the frame
+ * intervals a Gamma distribution on top of 35 ms, that is about 30 frames
+ * per second. The first frame and the frames below MinFrameSize are sent
+ * with MinFrameSize bytes.
+ */
+class HeVideoTrafficModel : public HeTrafficModel
+{
+public:
+  static TypeId GetTypeId (void);
+
+  HeVideoTrafficModel ();
+  virtual ~HeVideoTrafficModel ();
+
+  virtual uint32_t GetNextFrameSize (void);
+  virtual Time GetNextFrameInterval (void);
+  virtual int64_t AssignStreams (int64_t stream);
+
+  /**
+   * \param videoClass the video class, 1 to 6
+   * \param scale the Weibull scale (lambda) of the frame sizes in bytes
+   * \param shape the Weibull shape (k) of the frame sizes
+   */
+  static void GetWeibullParameters (uint8_t videoClass, double &scale, double &shape);
+
+private:
+  uint8_t m_videoClass;                     //!< Video class, 1 to 6
+  uint32_t m_minFrameSize;                  //!< Smallest frame in bytes
+  Time m_minFrameInterval;                  //!< Fixed part of the frame interval
+  double m_intervalAlpha;                   //!< Gamma shape of the variable part of the frame interval
+  double m_intervalBeta;                    //!< Gamma scale in seconds of the variable part of the frame interval
+  bool m_firstFrame;                        //!< No frame was sent yet
+  Ptr<WeibullRandomVariable> m_frameSize;   //!< Draws the frame sizes
+  Ptr<GammaRandomVariable> m_frameInterval; //!< Draws the frame intervals
+};
+
+/**
+ * \brief Full buffer best effort traffic
+ *
+ * Fixed size packets are sent at a fixed interval, short enough to keep
+ * the MAC queue of the station backlogged.
+ */
+class HeFullBufferTrafficModel : public HeTrafficModel
+{
+public:
+  static TypeId GetTypeId (void);
+
+  HeFullBufferTrafficModel ();
+  virtual ~HeFullBufferTrafficModel ();
+
+  virtual uint32_t GetNextFrameSize (void);
+  virtual Time GetNextFrameInterval (void);
+  virtual int64_t AssignStreams (int64_t stream);
+
+private:
+  uint32_t m_packetSize;                    //!< Packet size in bytes
+  Time m_interval;                          //!< Packet interval
+};
+
+} // namespace ns3
+
+#endif /* HE_TRAFFIC_MODEL_H */
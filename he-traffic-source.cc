@@ -0,0 +1,370 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/socket.h"
+#include "ns3/socket-factory.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/address.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/node.h"
+#include "ns3/pointer.h"
+#include "ns3/trace-source-accessor.h"
+#include "he-traffic-source.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("HeTrafficSource");
+
+NS_OBJECT_ENSURE_REGISTERED (HeTrafficHeader);
+NS_OBJECT_ENSURE_REGISTERED (HeTrafficSource);
+
+TypeId
+HeTrafficHeader::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::HeTrafficHeader")
+    .SetParent<Header> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<HeTrafficHeader> ()
+  ;
+  return tid;
+}
+
+TypeId
+HeTrafficHeader::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+HeTrafficHeader::HeTrafficHeader ()
+  : m_timestamp (0),
+    m_sequence (0)
+{
+}
+
+uint32_t
+HeTrafficHeader::GetSerializedSize (void) const
+{
+  return 12;
+}
+
+void
+HeTrafficHeader::Serialize (Buffer::Iterator start) const
+{
+  start.WriteU64 (m_timestamp);
+  start.WriteU32 (m_sequence);
+}
+
+uint32_t
+HeTrafficHeader::Deserialize (Buffer::Iterator start)
+{
+  m_timestamp = start.ReadU64 ();
+  m_sequence = start.ReadU32 ();
+  return GetSerializedSize ();
+}
+
+void
+HeTrafficHeader::Print (std::ostream &os) const
+{
+  os << "Timestamp=" << m_timestamp << "ns Sequence=" << m_sequence;
+}
+
+void
+HeTrafficHeader::SetTimestamp (Time timestamp)
+{
+  m_timestamp = timestamp.GetNanoSeconds ();
+}
+
+Time
+HeTrafficHeader::GetTimestamp (void) const
+{
+  return NanoSeconds (m_timestamp);
+}
+
+void
+HeTrafficHeader::SetSequence (uint32_t sequence)
+{
+  m_sequence = sequence;
+}
+
+uint32_t
+HeTrafficHeader::GetSequence (void) const
+{
+  return m_sequence;
+}
+
+TypeId
+HeTrafficSource::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::HeTrafficSource")
+    .SetParent<Application> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<HeTrafficSource> ()
+    .AddAttribute ("Remote",
+                   "The address of the destination",
+                   AddressValue (),
+                   MakeAddressAccessor (&HeTrafficSource::m_peer),
+                   MakeAddressChecker ())
+    .AddAttribute ("Protocol",
+                   "The type of protocol to use",
+                   TypeIdValue (UdpSocketFactory::GetTypeId ()),
+                   MakeTypeIdAccessor (&HeTrafficSource::m_tid),
+                   MakeTypeIdChecker ())
+    .AddAttribute ("Model",
+                   "Arrival and size model of the frames",
+                   PointerValue (),
+                   MakePointerAccessor (&HeTrafficSource::m_model),
+                   MakePointerChecker<HeTrafficModel> ())
+    .AddAttribute ("Tos",
+                   "IP type of service of the packets",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&HeTrafficSource::m_tos),
+                   MakeUintegerChecker<uint8_t> ())
+    .AddAttribute ("FragmentSize",
+                   "Largest packet in bytes, larger frames are sent as several packets",
+                   UintegerValue (500),
+                   MakeUintegerAccessor (&HeTrafficSource::m_fragmentSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("FragmentInterval",
+                   "Interval between the packets of a frame, 0 to send them as a burst",
+                   TimeValue (MicroSeconds (400)),
+                   MakeTimeAccessor (&HeTrafficSource::m_fragmentInterval),
+                   MakeTimeChecker ())
+    .AddAttribute ("WarmUpDelay",
+                   "Extra delay between the first frame and the second one",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&HeTrafficSource::m_warmUpDelay),
+                   MakeTimeChecker ())
+    .AddAttribute ("MaxPackets",
+                   "Number of packets to send, 0 for no limit",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&HeTrafficSource::m_maxPackets),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("Saturated",
+                   "Keep Watermark packets of the flow outstanding, refilled on NotifyDequeue, "
+                   "instead of following the frame intervals of the model",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&HeTrafficSource::m_saturated),
+                   MakeBooleanChecker ())
+    .AddAttribute ("Watermark",
+                   "Outstanding packets of a saturated flow",
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&HeTrafficSource::m_watermark),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("LossTimeout",
+                   "Time without NotifyDequeue after which the outstanding packets of a "
+                   "saturated flow are taken as lost",
+                   TimeValue (MilliSeconds (50)),
+                   MakeTimeAccessor (&HeTrafficSource::m_lossTimeout),
+                   MakeTimeChecker ())
+    .AddTraceSource ("Tx",
+                     "A packet was sent",
+                     MakeTraceSourceAccessor (&HeTrafficSource::m_txTrace),
+                     "ns3::Packet::TracedCallback")
+  ;
+  return tid;
+}
+
+HeTrafficSource::HeTrafficSource ()
+  : m_frames (0),
+    m_sent (0),
+    m_dequeued (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+HeTrafficSource::~HeTrafficSource ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+HeTrafficSource::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_socket = 0;
+  m_model = 0;
+  m_payload = 0;
+  Application::DoDispose ();
+}
+
+int64_t
+HeTrafficSource::AssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  return m_model->AssignStreams (stream);
+}
+
+uint32_t
+HeTrafficSource::GetSent (void) const
+{
+  return m_sent;
+}
+
+void
+HeTrafficSource::StartApplication (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (m_model != 0, "HeTrafficSource needs a Model");
+  if (m_socket == 0)
+    {
+      m_socket = Socket::CreateSocket (GetNode (), m_tid);
+      m_socket->SetAllowBroadcast (true);
+      m_socket->Connect (m_peer);
+      m_socket->SetIpTos (m_tos);
+    }
+  uint32_t headerSize = HeTrafficHeader ().GetSerializedSize ();
+  m_payload = Create<Packet> (m_fragmentSize > headerSize ? m_fragmentSize - headerSize : 0);
+  if (!m_saturated)
+    {
+      SendFrame ();
+      return;
+    }
+  // As the first frame of the model, one packet ahead of the warm up
+  SendPacket (std::min (m_model->GetNextFrameSize (), m_fragmentSize));
+  m_refillStart = Simulator::Now () + m_warmUpDelay;
+  m_lastDequeue = m_refillStart;
+  m_refill = Simulator::Schedule (m_warmUpDelay, &HeTrafficSource::Refill, this);
+  m_lossCheck = Simulator::Schedule (m_warmUpDelay + m_lossTimeout, &HeTrafficSource::CheckLoss, this);
+}
+
+void
+HeTrafficSource::StopApplication (void)
+{
+  NS_LOG_FUNCTION (this);
+  Simulator::Cancel (m_nextFrame);
+  Simulator::Cancel (m_refill);
+  Simulator::Cancel (m_lossCheck);
+  if (m_socket != 0)
+    {
+      m_socket->Close ();
+      m_socket = 0;
+    }
+}
+
+void
+HeTrafficSource::SendFrame (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_maxPackets && m_sent >= m_maxPackets)
+    {
+      return;
+    }
+  SendFragments (m_model->GetNextFrameSize ());
+  m_frames++;
+
+  Time interval = m_model->GetNextFrameInterval ();
+  if (m_frames == 1)
+    {
+      interval += m_warmUpDelay;
+    }
+  m_nextFrame = Simulator::Schedule (interval, &HeTrafficSource::SendFrame, this);
+}
+
+void
+HeTrafficSource::SendFragments (uint32_t left)
+{
+  NS_LOG_FUNCTION (this << left);
+  do
+    {
+      uint32_t size = std::min (left, m_fragmentSize);
+      if (!SendPacket (size))
+        {
+          return;
+        }
+      left -= size;
+    }
+  while (left > 0 && m_fragmentInterval.IsZero ());
+  // Each frame is paced on its own, the fragments of overlapping frames interleave
+  if (left > 0)
+    {
+      Simulator::Schedule (m_fragmentInterval, &HeTrafficSource::SendFragments, this, left);
+    }
+}
+
+bool
+HeTrafficSource::SendPacket (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  if (m_socket == 0 || (m_maxPackets && m_sent >= m_maxPackets))
+    {
+      return false;
+    }
+  HeTrafficHeader header;
+  header.SetTimestamp (Simulator::Now ());
+  header.SetSequence (++m_sent);
+  uint32_t headerSize = header.GetSerializedSize ();
+  Ptr<Packet> packet = m_payload->CreateFragment (0, size > headerSize ? size - headerSize : 0);
+  packet->AddHeader (header);
+  m_txTrace (packet);
+  m_socket->Send (packet);
+  return true;
+}
+
+void
+HeTrafficSource::NotifyDequeue (uint32_t sequence)
+{
+  NS_LOG_FUNCTION (this << sequence);
+  m_dequeued = std::max (m_dequeued, std::min (sequence, m_sent));
+  m_lastDequeue = Simulator::Now ();
+  // The notifications of one PPDU are served by a single refill
+  if (m_saturated && m_socket != 0 && !m_refill.IsRunning ()
+      && !(Simulator::Now () < m_refillStart))
+    {
+      m_refill = Simulator::ScheduleWithContext (GetNode ()->GetId (), Seconds (0),
+                                                 &HeTrafficSource::Refill, this);
+    }
+}
+
+void
+HeTrafficSource::Refill (void)
+{
+  NS_LOG_FUNCTION (this << m_sent - m_dequeued);
+  while (m_sent - m_dequeued < m_watermark
+         && SendPacket (std::min (m_model->GetNextFrameSize (), m_fragmentSize)))
+    {
+    }
+}
+
+void
+HeTrafficSource::CheckLoss (void)
+{
+  NS_LOG_FUNCTION (this);
+  Time idle = Simulator::Now () - m_lastDequeue;
+  if (idle < m_lossTimeout)
+    {
+      m_lossCheck = Simulator::Schedule (m_lossTimeout - idle, &HeTrafficSource::CheckLoss, this);
+      return;
+    }
+  if (m_sent > m_dequeued)
+    {
+      NS_LOG_DEBUG ("Taking " << m_sent - m_dequeued << " packets as lost");
+      m_dequeued = m_sent;
+      Refill ();
+    }
+  m_lossCheck = Simulator::Schedule (m_lossTimeout, &HeTrafficSource::CheckLoss, this);
+}
+
+} // namespace ns3
@@ -0,0 +1,188 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+
+#ifndef HE_TRAFFIC_SOURCE_H
+#define HE_TRAFFIC_SOURCE_H
+
+#include "ns3/application.h"
+#include "ns3/header.h"
+#include "ns3/address.h"
+#include "ns3/event-id.h"
+#include "ns3/traced-callback.h"
+#include "he-traffic-model.h"
+
+namespace ns3 {
+
+class Socket;
+class Packet;
+
+/**
+ * \brief Header of the packets of an HeTrafficSource
+ *
+ * The send time in nanoseconds (8 bytes) and the sequence number of the
+ * packet in its flow (4 bytes), both little endian, for the receiver to
+ * compute the latency and the jitter of the flow.
+ */
+class HeTrafficHeader : public Header
+{
+public:
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+
+  HeTrafficHeader ();
+
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+  virtual void Print (std::ostream &os) const;
+
+  /**
+   * \param timestamp the send time of the packet
+   */
+  void SetTimestamp (Time timestamp);
+  /**
+   * \return the send time of the packet
+   */
+  Time GetTimestamp (void) const;
+  /**
+   * \param sequence the sequence number of the packet, from 1
+   */
+  void SetSequence (uint32_t sequence);
+  /**
+   * \return the sequence number of the packet
+   */
+  uint32_t GetSequence (void) const;
+
+private:
+  uint64_t m_timestamp;   //!< Send time in nanoseconds
+  uint32_t m_sequence;    //!< Sequence number of the packet
+};
+
+/**
+ * \brief Traffic source of one flow of an OFDMA scenario
+ *
+ * The frames are drawn from an HeTrafficModel: VoIP talk spurts, Weibull
+ * sized video frames or full buffer best effort traffic. A frame larger
+ * than FragmentSize is sent as packets of FragmentSize bytes, FragmentInterval
+ * apart, or all at once from the event of the frame if FragmentInterval is
+ * zero. Each packet starts with an HeTrafficHeader, the rest of it being
+ * zero filled virtual bytes shared with a payload packet built at start.
+ *
+ * A Saturated source ignores the frame intervals of the model. It keeps
+ * Watermark packets of the flow outstanding, and sends new ones as it is
+ * notified by NotifyDequeue that packets left the MAC queue, so that the
+ * queue stays backlogged without one event per offered packet. As the
+ * queue is FIFO, a notification also accounts for the earlier packets,
+ * even if they were lost; when no notification comes for LossTimeout, all
+ * the outstanding packets are taken as lost.
+ *
+ * Every packet sent is reported by the Tx trace source, for the scenario
+ * to keep the stats of the flow.
+ */
+class HeTrafficSource : public Application
+{
+public:
+  static TypeId GetTypeId (void);
+
+  HeTrafficSource ();
+  virtual ~HeTrafficSource ();
+
+  /**
+   * Assign fixed random variable streams to the random variables of the model
+   *
+   * \param stream first stream index to use
+   * \return the number of stream indices assigned
+   */
+  int64_t AssignStreams (int64_t stream);
+  /**
+   * \return the number of packets sent so far
+   */
+  uint32_t GetSent (void) const;
+  /**
+   * Tell a Saturated source that a packet of its flow left the MAC queue,
+   * typically as it is received. The source tops the flow up to Watermark
+   * packets in the context of its node.
+   *
+   * \param sequence the HeTrafficHeader sequence number of the packet
+   */
+  void NotifyDequeue (uint32_t sequence);
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  virtual void StartApplication (void);
+  virtual void StopApplication (void);
+
+  /**
+   * Send a frame of the model and schedule the next one
+   */
+  void SendFrame (void);
+  /**
+   * Send the next fragment of a frame, or all of them if FragmentInterval
+   * is zero, and schedule the next one
+   *
+   * \param left the bytes of the frame not sent yet
+   */
+  void SendFragments (uint32_t left);
+  /**
+   * Send one packet of the current frame
+   *
+   * \param size the packet size in bytes, header included
+   */
+  bool SendPacket (uint32_t size);
+  /**
+   * Send packets until Watermark packets are outstanding
+   */
+  void Refill (void);
+  /**
+   * Take the outstanding packets as lost if no dequeue was notified for
+   * LossTimeout, and rearm the check
+   */
+  void CheckLoss (void);
+
+  Address m_peer;                     //!< Remote address
+  TypeId m_tid;                       //!< Socket factory
+  Ptr<HeTrafficModel> m_model;        //!< Frame arrivals and sizes
+  uint8_t m_tos;                      //!< IP type of service of the packets
+  uint32_t m_fragmentSize;            //!< Largest packet in bytes
+  Time m_fragmentInterval;            //!< Interval between the packets of a frame
+  Time m_warmUpDelay;                 //!< Extra delay between the first frame and the second one
+  uint32_t m_maxPackets;              //!< Packets to send, 0 for no limit
+  bool m_saturated;                   //!< Keep the flow at Watermark packets instead of following the model
+  uint32_t m_watermark;               //!< Outstanding packets of a saturated flow
+  Time m_lossTimeout;                 //!< Time without dequeue after which the outstanding packets are lost
+  Ptr<Socket> m_socket;               //!< Socket of the flow
+  uint32_t m_frames;                  //!< Frames sent
+  uint32_t m_sent;                    //!< Packets sent
+  EventId m_nextFrame;                //!< Next frame
+  Ptr<Packet> m_payload;              //!< Zero filled payload of a full fragment, copied by every packet
+  uint32_t m_dequeued;                //!< Sequence number of the last packet out of the MAC queue
+  Time m_refillStart;                 //!< End of the warm up of a saturated flow
+  Time m_lastDequeue;                 //!< Last dequeue notification
+  EventId m_refill;                   //!< Pending refill
+  EventId m_lossCheck;                //!< Next loss check
+  TracedCallback<Ptr<const Packet> > m_txTrace; //!< Packets sent
+};
+
+} // namespace ns3
+
+#endif /* HE_TRAFFIC_SOURCE_H */
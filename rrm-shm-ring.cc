@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#include <string.h>
+#include <new>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "rrm-shm-ring.h"
+
+static RrmShmSegment* rrmShmMap(const char* name,int flags)
+{
+    void* addr;
+    int fd = shm_open(name,flags,0600);
+
+    if(fd < 0){
+        return NULL;
+    }
+    if((flags & O_CREAT) && ftruncate(fd,sizeof(RrmShmSegment)) < 0){
+        close(fd);
+        return NULL;
+    }
+    addr = mmap(NULL,sizeof(RrmShmSegment),PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+    close(fd);
+    if(addr == MAP_FAILED){
+        return NULL;
+    }
+    return (RrmShmSegment*)addr;
+}
+
+/*
+ * Create a fresh segment, replacing the one left over by a previous run.
+ * Returns NULL on failure.
+ */
+RrmShmSegment* rrmShmCreate(const char* name)
+{
+    RrmShmSegment* segment;
+
+    shm_unlink(name);
+    segment = rrmShmMap(name,O_CREAT|O_EXCL|O_RDWR);
+    if(segment == NULL){
+        return NULL;
+    }
+    new (&segment->toServer.head) std::atomic<uint32_t>(0);
+    new (&segment->toServer.tail) std::atomic<uint32_t>(0);
+    new (&segment->toClient.head) std::atomic<uint32_t>(0);
+    new (&segment->toClient.tail) std::atomic<uint32_t>(0);
+    return segment;
+}
+
+/*
+ * Map the segment created by the RRM server. Returns NULL if it does not exist.
+ */
+RrmShmSegment* rrmShmAttach(const char* name)
+{
+    return rrmShmMap(name,O_RDWR);
+}
+
+void rrmShmDetach(RrmShmSegment* segment)
+{
+    if(segment){
+        munmap(segment,sizeof(RrmShmSegment));
+    }
+}
+
+void rrmShmDestroy(RrmShmSegment* segment,const char* name)
+{
+    rrmShmDetach(segment);
+    shm_unlink(name);
+}
+
+/*
+ * Append len bytes to the ring. Nothing is written unless all of them fit,
+ * so that the consumer never sees part of a frame from a full ring.
+ * Returns len, or 0 if the ring is full.
+ */
+int rrmShmRingWrite(RrmShmRing* ring,const char* data,int len)
+{
+    uint32_t head = ring->head.load(std::memory_order_relaxed);
+    uint32_t tail = ring->tail.load(std::memory_order_acquire);
+    uint32_t offset = head & (RRM_SHM_RING_SIZE - 1);
+    uint32_t first;
+
+    if(len <= 0 || (uint32_t)len > RRM_SHM_RING_SIZE - (head - tail)){
+        return 0;
+    }
+    first = RRM_SHM_RING_SIZE - offset;
+    if(first > (uint32_t)len){
+        first = len;
+    }
+    memcpy(ring->data+offset,data,first);
+    memcpy(ring->data,data+first,len-first);
+    ring->head.store(head+len,std::memory_order_release);
+    return len;
+}
+
+/*
+ * Take up to max bytes from the ring, like recv on a non-blocking socket.
+ * Returns the number of bytes copied, 0 if the ring is empty.
+ */
+int rrmShmRingRead(RrmShmRing* ring,char* data,int max)
+{
+    uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+    uint32_t head = ring->head.load(std::memory_order_acquire);
+    uint32_t offset = tail & (RRM_SHM_RING_SIZE - 1);
+    uint32_t len = head - tail;
+    uint32_t first;
+
+    if(max <= 0 || len == 0){
+        return 0;
+    }
+    if(len > (uint32_t)max){
+        len = max;
+    }
+    first = RRM_SHM_RING_SIZE - offset;
+    if(first > len){
+        first = len;
+    }
+    memcpy(data,ring->data+offset,first);
+    memcpy(data+first,ring->data,len-first);
+    ring->tail.store(tail+len,std::memory_order_release);
+    return len;
+}
+
+/*
+ * Queue one framed message. Returns the frame size, or 0 if the ring has
+ * no room for it yet.
+ */
+int rrmShmWriteFrame(RrmShmRing* ring,TlvBuffer* buf)
+{
+    char frame[TLV_FRAME_MAX_SIZE];
+    int size = tlvBuildFrame(buf,frame);
+
+    return rrmShmRingWrite(ring,frame,size);
+}
+
+/*
+ * Append whatever is queued in the ring to the reader.
+ * Returns the number of bytes appended, 0 if the ring is empty.
+ */
+int rrmShmFrameReaderFill(TlvFrameReader* reader,RrmShmRing* ring)
+{
+    int ret;
+
+    ret = rrmShmRingRead(ring,reader->data+reader->end,tlvFrameReaderPrepare(reader));
+    if(ret > 0){
+        reader->end += ret;
+    }
+    return ret;
+}
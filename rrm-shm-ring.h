@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#ifndef RRM_SHM_RING_H
+#define RRM_SHM_RING_H
+
+#include <stdint.h>
+#include <atomic>
+#include "tlv.h"
+
+/*
+ * Shared memory transport between ns-3 and a co-located RRM server.
+ *
+ * The segment holds two single producer / single consumer byte rings, one
+ * per direction, carrying the same length prefixed TLV frames as the framed
+ * TCP transport (see tlvBuildFrame). The RRM server creates the segment with
+ * rrmShmCreate and ns-3 attaches to it with rrmShmAttach, the way the server
+ * listens and ns-3 connects on the TCP path.
+ *
+ * Each ring index is written by one side only: head by the producer, tail
+ * by the consumer. They are free running counters, the offset in data is
+ * the counter modulo RRM_SHM_RING_SIZE.
+ */
+#define RRM_SHM_DEFAULT_NAME "/ns3-rrm"
+#define RRM_SHM_RING_SIZE (1 << 17)     //Power of two, holds several TLV_FRAME_MAX_SIZE frames
+#define RRM_SHM_CACHE_LINE 64
+
+typedef struct
+{
+    std::atomic<uint32_t> head;     //Bytes written so far by the producer
+    char pad0[RRM_SHM_CACHE_LINE - sizeof(std::atomic<uint32_t>)];
+    std::atomic<uint32_t> tail;     //Bytes read so far by the consumer
+    char pad1[RRM_SHM_CACHE_LINE - sizeof(std::atomic<uint32_t>)];
+    char data[RRM_SHM_RING_SIZE];
+}RrmShmRing;
+
+typedef struct
+{
+    RrmShmRing toServer;            //Requests and station reports from ns-3
+    RrmShmRing toClient;            //Requests and results from the RRM server
+}RrmShmSegment;
+
+RrmShmSegment* rrmShmCreate(const char* name);
+RrmShmSegment* rrmShmAttach(const char* name);
+void rrmShmDetach(RrmShmSegment* segment);
+void rrmShmDestroy(RrmShmSegment* segment,const char* name);
+
+int rrmShmRingWrite(RrmShmRing* ring,const char* data,int len);
+int rrmShmRingRead(RrmShmRing* ring,char* data,int max);
+int rrmShmWriteFrame(RrmShmRing* ring,TlvBuffer* buf);
+int rrmShmFrameReaderFill(TlvFrameReader* reader,RrmShmRing* ring);
+
+#endif //RRM_SHM_RING_H
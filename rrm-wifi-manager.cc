@@ -44,6 +44,9 @@
 #include "ns3/pointer.h"
 #include "ns3/type-id.h"
 #include "ns3/string.h"
+#include "ns3/enum.h"
+#include "ns3/object-factory.h"
+#include "ns3/trace-source-accessor.h"
 #include "ns3/rng-seed-manager.h"
 #include "ns3/he-bitmap.h"
 #include "snr-tag.h"
@@ -58,6 +61,7 @@
 #include "regular-wifi-mac.h"
 #include "ampdu-tag.h"
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <cstdint>
 
@@ -73,6 +77,8 @@
 #include <stdlib.h>                                                      
 #include <string>                                                        
 #include <time.h>                                                        
+#include <chrono>
+#include <sched.h>
 #include "tlv.h"
 
 #define PORTNUM 8888
@@ -82,6 +88,7 @@ int sd = 0 ;
 #define AC_VI 2
 #define AC_BK 1
 #define AC_BE 0
+#define HE_MU_PPDU_DURATION MicroSeconds(5472)   //Duration of the HE MU PPDUs, their TXOP lasts three
 
 #define RRM_MAC_COPY(dst,src) \
   dst[0] = src[0]; \
@@ -143,6 +150,75 @@ private:
   RRMWifiManager *m_RRMWifiManager;
 };
 
+uint32_t
+HeStationTable::Add (uint16_t staAid, uint8_t staAc, MacLowTransmissionListener *lt)
+{
+  aid.push_back (staAid);
+  ac.push_back (staAc);
+  listener.push_back (lt);
+  needsAccess.push_back (false);
+  bufferedBytes.push_back (0);
+  holTimestamp.push_back (Seconds (0));
+  throughputDL.push_back (0);
+  ulBufferDepth.push_back (0xffffffff);
+  ulReportTime.push_back (Now ());
+  mcs.push_back (HE_STATION_NO_MCS);
+  lastSnr.push_back (0);
+  queueChanged.push_back (false);
+  // The queue may already hold packets
+  MarkQueueChanged (aid.size () - 1);
+  return aid.size () - 1;
+}
+
+uint32_t
+HeStationTable::GetN (void) const
+{
+  return aid.size ();
+}
+
+void
+HeStationTable::MarkQueueChanged (uint32_t row)
+{
+  if (!queueChanged[row])
+    {
+      queueChanged[row] = true;
+      changedRows.push_back (row);
+    }
+}
+
+void
+HePlanBaseline::Take (const HeStationTable &table)
+{
+  bufferedBytes = table.bufferedBytes;
+  ulBufferDepth = table.ulBufferDepth;
+  lastSnr = table.lastSnr;
+}
+
+bool
+HePlanBaseline::IsOutdated (const HeStationTable &table, double snrHysteresis) const
+{
+  if (bufferedBytes.size () != table.GetN ())
+    {
+      return true;
+    }
+  // Queues drained by the plan are expected. A queue deeper than when the
+  // plan was computed, or a new UL report of such a backlog, had arrivals
+  // the plan did not account for.
+  for (uint32_t i = AC_BE_NQOS; i < table.GetN (); i++)
+    {
+      uint32_t ul = table.ulBufferDepth[i];
+      double snr = table.lastSnr[i];
+      if (table.bufferedBytes[i] > bufferedBytes[i]
+          || (ul != 0xffffffff && ul > 0 && (ulBufferDepth[i] == 0xffffffff || ul > ulBufferDepth[i]))
+          || (snr > 0 && (lastSnr[i] == 0 || std::fabs (10 * std::log10 (snr / lastSnr[i])) > snrHysteresis)))
+        {
+          NS_LOG_DEBUG ("Plan outdated by queue " << i);
+          return true;
+        }
+    }
+  return false;
+}
+
 int 
 RRMWifiManager::SendDLStations(bool isEmptyBufReq){
     short stationids[] = {1,2,3,56,123};
@@ -151,7 +227,7 @@ RRMWifiManager::SendDLStations(bool isEmptyBufReq){
                                                                                  
     memset(message->data,0x00,BUFFER_DATA_MAX_SIZE);
     tlvEncode2ByteIntArray(message,TYPE_11AX_DL_STATION_MAC_RESP,stationids,5);
-    write(sd,(void*)message,sizeof(TlvBuffer));
+    SendTlvMessage(sd, message);
     free(message);
     return 1;
 }
@@ -163,7 +239,7 @@ RRMWifiManager::SendULStations(bool isEmptyBufReq){
                                                                                  
     memset(message->data,0x00,BUFFER_DATA_MAX_SIZE);
     tlvEncode2ByteIntArray(message,TYPE_11AX_UL_STATION_MAC_RESP,stationids,4);
-    write(sd,(void*)message,sizeof(TlvBuffer));
+    SendTlvMessage(sd, message);
     free(message);
 
     return 1;
@@ -175,8 +251,8 @@ RRMWifiManager::SendAllInfo(bool isEmptyReq)
   uint16_t lastServedStation = 3, totalAxStations = m_axStations.size(), i;
   AllStats_t clientArray[100];
   uint32_t index = 0;
-  Ptr<WifiMacQueue> queue;
-  WifiMacHeader hdr;
+  const HeStationTable &table = m_stationTable;
+  double now = Now().GetMilliSeconds();
   //uint32_t t_ac = 0;
 
   memset(&clientArray, '\0', sizeof(clientArray));
@@ -187,14 +263,14 @@ RRMWifiManager::SendAllInfo(bool isEmptyReq)
       for (uint32_t ac  = 0; ac < AC_BE_NQOS; ac++)
         {
 	  //Downlink buffer informtion
-	  clientArray[index].bufferDepthDL[ac] = m_axStations[i+ac]->lt->GetQueue ()->GetBytes ();
-          clientArray[index].WaitingTimeDL[ac] = std::round(Now().GetMilliSeconds() - m_axStations[i+ac]->lt->PeekFirstPacket(&hdr).GetMilliSeconds());
-          clientArray[index].ThroughputDL[ac] = m_axStations[i+ac]->lt->GetQueue ()->GetThroughput();
+	  clientArray[index].bufferDepthDL[ac] = table.bufferedBytes[i+ac];
+          clientArray[index].WaitingTimeDL[ac] = std::round(now - table.holTimestamp[i+ac].GetMilliSeconds());
+          clientArray[index].ThroughputDL[ac] = table.throughputDL[i+ac];
 	  //Uplink buffer information
-          clientArray[index].bufferDepthUL[ac] = m_axStations[i+ac]->ulBufferStat.bufLen;
-          clientArray[index].WaitingTimeUL[ac] = std::round(Now().GetMilliSeconds() - m_axStations[i+ac]->ulBufferStat.time.GetMilliSeconds());
+          clientArray[index].bufferDepthUL[ac] = table.ulBufferDepth[i+ac];
+          clientArray[index].WaitingTimeUL[ac] = std::round(now - table.ulReportTime[i+ac].GetMilliSeconds());
           mcsVal = rateControlIdeal(m_axStations[i+ac]);
-          if ( mcsVal != 0xff)
+          if ( mcsVal != HE_STATION_NO_MCS)
           mcs = mcsVal;
         }
         clientArray[index].mcsVal = mcs;
@@ -214,9 +290,9 @@ RRMWifiManager::SendAllInfo(bool isEmptyReq)
     }
 
   tlvEncodeAllStats(message, TYPE_11AX_ALL_STATS_RESP, clientArray, index); //last is number of clients
-  write(sd, (void*)message, sizeof(TlvBuffer));
+  bool sent = SendTlvMessage(sd, message);
   free(message);
-  return 1;
+  return sent ? 1 : -1;
 }
 
 
@@ -271,7 +347,7 @@ RRMWifiManager::HandleDLMCSInfoRequest(TlvBuffer* message){
             tlvAppend2Bytes(mcsInfoResp,mcs);              
             tlvAppend2Bytes(mcsInfoResp,ru);    
 	}
-	write(sd,(void*)mcsInfoResp,sizeof(TlvBuffer));
+	SendTlvMessage(sd, mcsInfoResp);
 	free(mcsInfoResp);
         return 1;
     }else{
@@ -311,7 +387,7 @@ RRMWifiManager::HandleULMCSInfoRequest(TlvBuffer* message){
             tlvAppend2Bytes(mcsInfoResp,mcs);              
             tlvAppend2Bytes(mcsInfoResp,ru);    
 	}
-	write(sd,(void*)mcsInfoResp,sizeof(TlvBuffer));
+	SendTlvMessage(sd, mcsInfoResp);
 	free(mcsInfoResp);
         return 1;
     }else{
@@ -414,7 +490,7 @@ RRMWifiManager::HandleBufferDepthRequest(TlvBuffer* message,bool isDL){
    }
    printf("The buffer depth response is \n");
    print_bytes(bufferDepthResp->data,BUFFER_DATA_MAX_SIZE);
-   write(sd,(void*)bufferDepthResp,sizeof(TlvBuffer));
+   SendTlvMessage(sd, bufferDepthResp);
    free(bufferDepthResp);
    return 1;
 }
@@ -452,7 +528,7 @@ RRMWifiManager::HandleWaitingTimeRequest(TlvBuffer* message,bool isDL){
    }              
    printf("The waitingTimeResponse is\n");
    print_bytes(waitingTimeResp->data,100);
-   write(sd,(void*)waitingTimeResp,sizeof(TlvBuffer));
+   SendTlvMessage(sd, waitingTimeResp);
    free(waitingTimeResp);
    return 1;
 }
@@ -474,11 +550,9 @@ RRMWifiManager::HandleRRMResults(TlvBuffer* message, bool isDownlink)
 	short i;
 	short count;
 	RRMClientResponse_t* respArray = 0;
-        uint32_t axStationIndex = 0;
-        WifiTxVector txVector;
-        ServingStations servingStations;
+        HeRuAssignment assignment;
 
-        servingStations.clear();
+        m_assignments.clear();
 	tlvDecodeResults(message,&respArray,&count);
 	for(i = 0;i<count;i++)
 	{
@@ -491,24 +565,51 @@ RRMWifiManager::HandleRRMResults(TlvBuffer* message, bool isDownlink)
 		printf("Channel Width : %d\n",respArray[i].chanW);
                 PrintCurrentTime();
 #endif
-                axStationIndex = FectchAxStationIndexFromMac(respArray[i].macStr, respArray[i].trafficType);
-                //printf("AX Index : %d\n", axStationIndex);
-                txVector = DoGetDataTxVector (m_axStations[axStationIndex], respArray[i].ruBitMap, m_axStations[axStationIndex]->m_aid, respArray[i].mcsValue);
-                txVector.SetRu(respArray[i].ruBitMap);
-                txVector.SetChannelWidth(respArray[i].chanW);
-                txVector.SetAid(m_axStations[axStationIndex]->m_aid);
-                m_axStations[axStationIndex]->dataTxVector = txVector;
-                servingStations.push_back(m_axStations[axStationIndex]);
+                assignment.index = FectchAxStationIndexFromMac(respArray[i].macStr, respArray[i].trafficType);
+                //printf("AX Index : %d\n", assignment.index);
+                assignment.ruBitMap = respArray[i].ruBitMap;
+                assignment.mcs = respArray[i].mcsValue;
+                assignment.chanW = respArray[i].chanW;
+                m_assignments.push_back(assignment);
 	}
 
 	if(respArray)
 	  {
             free(respArray);
 	  }
-        if(count > 0) {
-            return StartTranmission(isDownlink, servingStations);
+        if(m_rrmRoundExpired) {
+            // The round already fell back to the sample schedulers
+            NS_LOG_DEBUG("Discarding late RRM results");
+            return false;
         }
-        return false;
+        m_rrmScheduled = ApplyRuAssignments(isDownlink, m_assignments);
+        return m_rrmScheduled;
+}
+
+bool
+RRMWifiManager::ApplyRuAssignments (bool isDownlink, const HeRuAssignmentList &assignments)
+{
+  NS_LOG_FUNCTION (this << isDownlink << assignments.size ());
+  ServingStations servingStations;
+  WifiTxVector txVector;
+
+  if (assignments.empty ())
+    {
+      return false;
+    }
+  servingStations.reserve (assignments.size ());
+  for (HeRuAssignmentList::const_iterator it = assignments.begin (); it != assignments.end (); it++)
+    {
+      NS_ASSERT (it->index < m_axStations.size ());
+      RRMWifiRemoteStation *station = m_axStations[it->index];
+      txVector = DoGetDataTxVector (station, it->ruBitMap, m_stationTable.aid[it->index], it->mcs);
+      txVector.SetRu (it->ruBitMap);
+      txVector.SetChannelWidth (it->chanW);
+      txVector.SetAid (m_stationTable.aid[it->index]);
+      station->dataTxVector = txVector;
+      servingStations.push_back (station);
+    }
+  return StartTranmission (isDownlink, servingStations);
 }
 
 int 
@@ -533,6 +634,12 @@ RRMWifiManager::ProcessTlvMessage(TlvBuffer* message, bool isDownlink)
         switch(type){
 	    case TYPE_11AX_ALL_STATS_REQ:
 		tlvDecode1Byte(message,&isEmptyReq);
+		if(m_rrmStatsPushed) {
+		    // The server asks for the snapshot pushed with the request
+		    NS_LOG_DEBUG("Snapshot of the round already sent");
+		    m_rrmStatsPushed = false;
+		    break;
+		}
 		SendAllInfo(isEmptyReq);
 		break;
 	    case TYPE_11AX_RRM_RESULTS_RESP:
@@ -584,13 +691,14 @@ RRMWifiManager::NotifyAccessGranted (void)
   for (uint8_t  tid = 0; tid < 8; tid++)
     {
       RRMWifiRemoteStation *station = m_axStations[QosUtilsMapTidToAc(tid)];
-      MacLowTransmissionListener *listener = station->lt;
+      MacLowTransmissionListener *listener = m_stationTable.listener[station->m_tableIndex];
       if (listener->NeedsAccess())
         {
 	  WifiTxVector txVector = DoGetDataTxVector(station);
 	  txVector.SetRu(0xff);
           //If there is something in the broadcast (aid == 0) queue, we have to send it on priority
 	  listener->NotifyAccessGranted(txVector, MilliSeconds(1));
+	  NotifyQueueChanged(station);
           isBroadcastServed = true;
           break;
         }
@@ -734,6 +842,84 @@ RRMWifiManager::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&RRMWifiManager::m_SchedulerPluginEnabled),
                    MakeBooleanChecker ())
+    .AddAttribute ("FramedTlv",
+                   "Exchange length prefixed TLV frames with the RRM server instead of "
+                   "fixed size TlvBuffer records. The server must use the same framing.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RRMWifiManager::m_framedTlv),
+                   MakeBooleanChecker ())
+    .AddAttribute ("RrmTransport",
+                   "Transport to the RRM server: a TCP connection, or shared memory rings "
+                   "for a server running on the same host. Shared memory always uses "
+                   "length prefixed frames.",
+                   EnumValue (RRM_TRANSPORT_TCP),
+                   MakeEnumAccessor (&RRMWifiManager::m_rrmTransport),
+                   MakeEnumChecker (RRM_TRANSPORT_TCP, "Tcp",
+                                    RRM_TRANSPORT_SHM, "SharedMemory"))
+    .AddAttribute ("RrmShmName",
+                   "Name of the POSIX shared memory object created by the RRM server "
+                   "when RrmTransport is SharedMemory.",
+                   StringValue (RRM_SHM_DEFAULT_NAME),
+                   MakeStringAccessor (&RRMWifiManager::m_rrmShmName),
+                   MakeStringChecker ())
+    .AddAttribute ("RrmAsync",
+                   "Pipeline the exchange with the RRM server: the request of the next "
+                   "round is sent as soon as a round is consumed, along with the station "
+                   "snapshot, and the results are picked up at the following channel "
+                   "access. The server may still ask for the snapshot with ALL_STATS_REQ: "
+                   "the first request of a round is not answered, the pushed snapshot "
+                   "standing for the response.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RRMWifiManager::m_rrmAsync),
+                   MakeBooleanChecker ())
+    .AddAttribute ("RrmDeadline",
+                   "Wall clock time the RRM server has to return the results of a round "
+                   "in asynchronous mode before the sample schedulers are used instead. "
+                   "It also bounds the wait for room in the shared memory ring to the server.",
+                   TimeValue (MilliSeconds (10)),
+                   MakeTimeAccessor (&RRMWifiManager::m_rrmDeadline),
+                   MakeTimeChecker ())
+    .AddAttribute ("SchedulerPluginType",
+                   "TypeId name of the in-process HeSchedulerPlugin used when SchedulerPlugin is enabled. "
+                   "When empty, the external RRM server is used instead.",
+                   StringValue (""),
+                   MakeStringAccessor (&RRMWifiManager::SetSchedulerPluginType,
+                                       &RRMWifiManager::GetSchedulerPluginType),
+                   MakeStringChecker ())
+    .AddAttribute ("LookaheadTxops",
+                   "Number of TXOPs, alternately DL and UL, planned at once by the in-process "
+                   "scheduler plugin. The plan is used until it is exhausted or a queue "
+                   "arrival, a buffer status report or an SNR change makes it out of date. "
+                   "1 runs the scheduler at each TXOP.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&RRMWifiManager::m_lookaheadTxops),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("PlanSnrHysteresis",
+                   "SNR change of a station, in dB, above which a lookahead plan is "
+                   "computed again",
+                   DoubleValue (3),
+                   MakeDoubleAccessor (&RRMWifiManager::m_planSnrHysteresis),
+                   MakeDoubleChecker<double> (0))
+    .AddTraceSource ("RrmTxBytes",
+                     "Total number of bytes sent to the RRM server",
+                     MakeTraceSourceAccessor (&RRMWifiManager::m_rrmTxBytes),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("RrmMissedRounds",
+                     "Number of asynchronous rounds whose results missed the deadline",
+                     MakeTraceSourceAccessor (&RRMWifiManager::m_rrmMissedRounds),
+                     "ns3::TracedValueCallback::Uint32")
+    .AddTraceSource ("RrmLateRounds",
+                     "Number of asynchronous rounds whose results arrived after the deadline",
+                     MakeTraceSourceAccessor (&RRMWifiManager::m_rrmLateRounds),
+                     "ns3::TracedValueCallback::Uint32")
+    .AddTraceSource ("PlannedTxops",
+                     "Number of TXOPs scheduled by the lookahead planner",
+                     MakeTraceSourceAccessor (&RRMWifiManager::m_plannedTxops),
+                     "ns3::TracedValueCallback::Uint32")
+    .AddTraceSource ("Replans",
+                     "Number of lookahead plans discarded before their last TXOP",
+                     MakeTraceSourceAccessor (&RRMWifiManager::m_replans),
+                     "ns3::TracedValueCallback::Uint32")
   ;
   return tid;
 }
@@ -744,6 +930,21 @@ RRMWifiManager::RRMWifiManager ()
   m_dcf = new RRMWifiManager::Dcf (this);
   m_rng = new RealRandomStream ();
   m_ruTable = CreateObject<HEBitMap> ();
+  m_rrmTxBytes = 0;
+  m_rrmRoundPending = false;
+  m_rrmRoundExpired = false;
+  m_rrmStatsPushed = false;
+  m_rrmRoundDownlink = true;
+  m_rrmScheduled = false;
+  m_rrmRounds = 0;
+  m_rrmMissedRounds = 0;
+  m_rrmLateRounds = 0;
+  m_rrmShm = 0;
+  m_nextScheduleUplink = false;
+  m_plannedTxops = 0;
+  m_replans = 0;
+  m_axStationSlotsUsed = 0;
+  tlvFrameReaderInit(&m_rrmReader);
   m_sockId = socket(AF_INET, SOCK_STREAM, 0);
   EstablishRRMServerConnection();
 }
@@ -752,11 +953,17 @@ RRMWifiManager::~RRMWifiManager ()
 {
   NS_LOG_FUNCTION (this);
   close(m_sockId);
+  rrmShmDetach(m_rrmShm);
 }
 
 void
 RRMWifiManager::DoInitialize ()
 {
+  // Attributes are only known now, the TCP connection is made by the constructor
+  if (m_rrmTransport == RRM_TRANSPORT_SHM)
+    {
+      AttachRrmShm ();
+    }
   m_wifiPhy->TraceConnectWithoutContext("PhyRxDrop", MakeCallback(&RRMWifiManager::RxDrop, this));
   WifiMode mode;
   WifiTxVector txVector;
@@ -798,10 +1005,6 @@ RRMWifiManager::SetupAidQueue (uint16_t aid, Mac48Address mac, MacLowTransmissio
       if (QosUtilsMapTidToAc (tid) == ac && !(tid % 2))
 	{
 	  RRMWifiRemoteStation *station = (RRMWifiRemoteStation *)Lookup(mac, tid);
-	  station->m_aid = aid;
-	  station->lt = lt;
-	  station->ulBufferStat.bufLen = -1;
-	  station->ulBufferStat.time = Now();
           station->m_successThreshold = m_minSuccessThreshold;
           station->m_timerTimeout = m_minTimerThreshold;
           station->m_success = 0;
@@ -809,10 +1012,12 @@ RRMWifiManager::SetupAidQueue (uint16_t aid, Mac48Address mac, MacLowTransmissio
           station->m_recovery = false;
           station->m_retry = 0;
           station->m_timer = 0;
-          station->m_mcsVal = 0xff;
           station->m_arfSuccessThreshold = 4;
           station->m_arfFailureThreshold = 4;
 	  m_axStations.push_back(station);
+	  station->m_tableIndex = m_stationTable.Add (aid, ac, lt);
+	  NS_ASSERT (station->m_tableIndex == m_axStations.size () - 1);
+	  IndexAxStation (m_axStations.size () - 1);
 	}
     }
 }
@@ -822,8 +1027,7 @@ RRMWifiManager::DoCreateStation (void) const
 {
   NS_LOG_FUNCTION (this);
   RRMWifiRemoteStation *station = new RRMWifiRemoteStation ();
-  station->m_aid = 0;
-  station->m_lastSnrObserved = 0.0;
+  station->m_tableIndex = HE_STATION_NO_ROW;
   station->m_lastSnrCached = CACHE_INITIAL_VALUE;
   return station;
 }
@@ -847,7 +1051,10 @@ RRMWifiManager::GetAcStaleTime(uint ac)
 void
 RRMWifiManager::StaleBSData (RRMWifiRemoteStation *st)
 {
-  st->ulBufferStat.bufLen = -1;
+  if (st->m_tableIndex != HE_STATION_NO_ROW)
+    {
+      m_stationTable.ulBufferDepth[st->m_tableIndex] = 0xffffffff;
+    }
   st->ulBSStaleTimer = Simulator::Schedule (NanoSeconds(st->ulBSStaleTimer.GetTs()), &RRMWifiManager::StaleBSData, this, st);
 }
 
@@ -858,16 +1065,23 @@ RRMWifiManager::DoReportRxOk (WifiRemoteStation *station,
   RRMWifiRemoteStation *st = (RRMWifiRemoteStation *)station;
   if (st->m_state->m_heSupported && st->m_state->m_isTxopLimitValid)
     {
+      uint8_t mac[6];
+      st->m_state->m_address.CopyTo (mac);
       for (uint ac  = 0; ac < AC_BE_NQOS; ac++)
         {
-	  RRMWifiRemoteStation *sta = (RRMWifiRemoteStation *)Lookup(st->m_state->m_address, ac*2);
-	  if(st->m_state->m_Qsize[ac])
+	  uint32_t index = FectchAxStationIndexFromMac (mac, ac);
+	  // Index 0 is a broadcast queue, never the queue of the sender
+	  if (index != 0)
 	    {
-	      sta->ulBSStaleTimer.Cancel();
-	      sta->ulBSStaleTimer = Simulator::Schedule (GetAcStaleTime(ac), &RRMWifiManager::StaleBSData, this, sta);
+	      RRMWifiRemoteStation *sta = m_axStations[index];
+	      if(st->m_state->m_Qsize[ac])
+	        {
+	          sta->ulBSStaleTimer.Cancel();
+	          sta->ulBSStaleTimer = Simulator::Schedule (GetAcStaleTime(ac), &RRMWifiManager::StaleBSData, this, sta);
+	        }
+	      m_stationTable.ulBufferDepth[index] = st->m_state->m_Qsize[ac]*256;
+	      m_stationTable.ulReportTime[index] = Now();
 	    }
-	  sta->ulBufferStat.bufLen = st->m_state->m_Qsize[ac]*256;
-	  sta->ulBufferStat.time = Now();
 	  //Timer to make this data stale after a timeout
 	  st->m_state->m_isTxopLimitValid = false;
         }
@@ -878,7 +1092,7 @@ RRMWifiManager::DoReportRxOk (WifiRemoteStation *station,
 	  st->ulBSStaleTimer = Simulator::Schedule (MilliSeconds(30), &RRMWifiManager::StaleBSData, this, st);
 	}
       //If we are here, we have successfully received UL Data frame.
-      st->m_lastSnrObserved = rxSnr;
+      SetLastSnr(st, rxSnr);
       rateControlDataSuccess(st);
     }
 }
@@ -886,12 +1100,14 @@ RRMWifiManager::DoReportRxOk (WifiRemoteStation *station,
 void
 RRMWifiManager::DoReportRtsFailed (WifiRemoteStation *station)
 {
+  NotifyQueueChanged((RRMWifiRemoteStation *)station);
 }
 
 void
 RRMWifiManager::DoReportDataFailed (WifiRemoteStation *station)
 {
   RRMWifiRemoteStation *st = (RRMWifiRemoteStation *)station;
+  NotifyQueueChanged(st);
   rateControlDataFailed(st);
 }
 
@@ -901,7 +1117,7 @@ RRMWifiManager::DoReportRtsOk (WifiRemoteStation *st,
 {
   RRMWifiRemoteStation *sta = (RRMWifiRemoteStation *)st;
   NS_LOG_FUNCTION (this << sta << ctsSnr << ctsMode.GetUniqueName () << rtsSnr);
-  sta->m_lastSnrObserved = rtsSnr;
+  SetLastSnr(sta, rtsSnr);
 }
 
 void
@@ -910,7 +1126,8 @@ RRMWifiManager::DoReportDataOk (WifiRemoteStation *station,
 {
   NS_LOG_FUNCTION (this << station << ackSnr << ackMode.GetUniqueName () << dataSnr);
   RRMWifiRemoteStation *st = (RRMWifiRemoteStation *)station;
-  st->m_lastSnrObserved = dataSnr;
+  SetLastSnr(st, dataSnr);
+  NotifyQueueChanged(st);
   rateControlDataSuccess(st);
 }
 
@@ -919,7 +1136,8 @@ RRMWifiManager::DoReportAmpduTxStatus (WifiRemoteStation *station, uint32_t nSuc
 {
   NS_LOG_FUNCTION (this << station << nSuccessfulMpdus << nFailedMpdus << rxSnr << dataSnr);
   RRMWifiRemoteStation *st = (RRMWifiRemoteStation *)station;
-  st->m_lastSnrObserved = dataSnr;
+  SetLastSnr(st, dataSnr);
+  NotifyQueueChanged(st);
 
   if (nSuccessfulMpdus == 0)
     {
@@ -935,12 +1153,14 @@ RRMWifiManager::DoReportAmpduTxStatus (WifiRemoteStation *station, uint32_t nSuc
 void
 RRMWifiManager::DoReportFinalRtsFailed (WifiRemoteStation *station)
 {
+  NotifyQueueChanged((RRMWifiRemoteStation *)station);
 }
 
 void
 RRMWifiManager::DoReportFinalDataFailed (WifiRemoteStation *station)
 {
   RRMWifiRemoteStation *st = (RRMWifiRemoteStation *)station;
+  NotifyQueueChanged(st);
   rateControlDataFailed(st);
 }
 
@@ -1005,6 +1225,14 @@ void
 RRMWifiManager::PrepareForQueue (Mac48Address address, const WifiMacHeader *header, Ptr<const Packet> packet)
 {
   WifiRemoteStationManager::PrepareForQueue (address, header, packet);
+  // The packet is queued on return, its queue is read at the next round
+  uint8_t mac[6];
+  address.CopyTo (mac);
+  uint32_t index = FectchAxStationIndexFromMac (mac, QosUtilsMapTidToAc (header->IsQosData () ? header->GetQosTid () : 0));
+  if (index < m_stationTable.GetN ())
+    {
+      m_stationTable.MarkQueueChanged (index);
+    }
   //Request access for next round
   StartAccessIfNeeded();
 }
@@ -1015,7 +1243,8 @@ RRMWifiManager::PrepareHeMuMpdu(ServingStations servingStations)
   for(ServingStations::iterator s = servingStations.begin(); s != servingStations.end(); s++)
   {
       // Dequeue one packet from the queue and add it to the HE MU MPDU
-      (*s)->lt->NotifyAccessGranted((*s)->dataTxVector, MicroSeconds(5472*3));
+      m_stationTable.listener[(*s)->m_tableIndex]->NotifyAccessGranted((*s)->dataTxVector, 3*HE_MU_PPDU_DURATION);
+      m_stationTable.MarkQueueChanged((*s)->m_tableIndex);
   }
 }
 
@@ -1023,11 +1252,23 @@ bool
 RRMWifiManager::ScheduleStations(void)
 {
   NS_LOG_FUNCTION(this);
-  static bool nextScheduleUplink = false;
   bool isScheduled = false;
-  if (m_SchedulerPluginEnabled)
+  UpdateChangedQueues ();
+  if (m_SchedulerPluginEnabled && m_scheduler != 0 && m_lookaheadTxops > 1)
+    {
+      isScheduled = CallSchedulerPlanner (!m_nextScheduleUplink);
+    }
+  else if (m_SchedulerPluginEnabled && m_scheduler != 0)
     {
-      isScheduled = CallAlgoPlugin(!nextScheduleUplink);
+      isScheduled = CallSchedulerPlugin (!m_nextScheduleUplink);
+    }
+  else if (m_SchedulerPluginEnabled && m_rrmAsync)
+    {
+      isScheduled = CallAlgoPluginAsync (!m_nextScheduleUplink);
+    }
+  else if (m_SchedulerPluginEnabled)
+    {
+      isScheduled = CallAlgoPlugin(!m_nextScheduleUplink);
     }
   else
     {
@@ -1035,7 +1276,7 @@ RRMWifiManager::ScheduleStations(void)
        * Following sample resource allocation methods are for 20MHZ only. it just allocates 26 tone resource unit
        * to each station.
        */
-      if (nextScheduleUplink)
+      if (m_nextScheduleUplink)
 	{
 	  isScheduled = SampleULScheduler();
 	}
@@ -1044,7 +1285,7 @@ RRMWifiManager::ScheduleStations(void)
 	  isScheduled = SampleDLScheduler();
 	}
     }
-  nextScheduleUplink = !nextScheduleUplink;
+  m_nextScheduleUplink = !m_nextScheduleUplink;
   return isScheduled;
 }
 
@@ -1064,11 +1305,10 @@ RRMWifiManager::SampleDLScheduler(void)
   WifiTxVector txVector;
   struct RUInfo                     ruI = {0,0};
   uint32_t bitMap = 0;
-  Ptr<UniformRandomVariable> mcsRandom = CreateObject<UniformRandomVariable> ();
 
   for (i = lastServedStation + 1; i < totalAxStations; i++)
     {
-      if(m_axStations[i]->lt->NeedsAccess())
+      if(m_stationTable.needsAccess[i])
 	{
 	      //Populate ruMap
               ruI.type = 1;
@@ -1079,7 +1319,7 @@ RRMWifiManager::SampleDLScheduler(void)
 
               //XXX: Seleting 26 tone RU for 9 stations
               txVector.SetRu(bitMap);
-	      txVector.SetAid(m_axStations[i]->m_aid);
+	      txVector.SetAid(m_stationTable.aid[i]);
               txVector.SetChannelWidth(2);
 	      m_axStations[i]->dataTxVector = txVector;
 	      servingStaions.push_back (m_axStations[i]);
@@ -1122,7 +1362,7 @@ RRMWifiManager::SampleULScheduler()
 
   for (i = lastServedStation + 1; i < totalAxStations;i++)
     {
-      it = find (selectedAid.begin(), selectedAid.end(), m_axStations[i]->m_aid);
+      it = find (selectedAid.begin(), selectedAid.end(), m_stationTable.aid[i]);
 
       if(it == selectedAid.end())
       { 
@@ -1134,8 +1374,8 @@ RRMWifiManager::SampleULScheduler()
          txVector.SetRu(m_ruTable->GetBitMapFromRUInfo(ruI));
          ruI.index ++;
 
-         txVector.SetAid(m_axStations[i]->m_aid);
-         selectedAid.push_back(m_axStations[i]->m_aid);
+         txVector.SetAid(m_stationTable.aid[i]);
+         selectedAid.push_back(m_stationTable.aid[i]);
          m_axStations[i]->dataTxVector = txVector;
          servingStaions.push_back (m_axStations[i]);
          currListOfStations++;
@@ -1182,6 +1422,250 @@ RRMWifiManager::GetSiMax () const
   return m_siMax;
 }
 
+void
+RRMWifiManager::SetSchedulerPluginType (std::string type)
+{
+  NS_LOG_FUNCTION (this << type);
+  m_schedulerPluginType = type;
+  m_scheduler = 0;
+  if (!type.empty ())
+    {
+      ObjectFactory factory;
+      factory.SetTypeId (type);
+      m_scheduler = factory.Create<HeSchedulerPlugin> ();
+    }
+}
+
+std::string
+RRMWifiManager::GetSchedulerPluginType (void) const
+{
+  return m_schedulerPluginType;
+}
+
+void
+RRMWifiManager::TakeStationSnapshot (void)
+{
+  NS_LOG_FUNCTION (this);
+  HeStationSnapshot entry;
+  const HeStationTable &table = m_stationTable;
+
+  m_snapshot.clear ();
+  // The first AC_BE_NQOS entries are the broadcast queues
+  for (uint32_t i = AC_BE_NQOS; i < table.GetN (); i++)
+    {
+      RRMWifiRemoteStation *st = m_axStations[i];
+      entry.index = i;
+      entry.aid = table.aid[i];
+      entry.address = st->m_state->m_address;
+      entry.ac = table.ac[i];
+      entry.needsAccess = table.needsAccess[i];
+      entry.bufferDepthDL = table.bufferedBytes[i];
+      entry.waitingTimeDL = entry.bufferDepthDL ? Now () - table.holTimestamp[i] : Seconds (0);
+      entry.throughputDL = table.throughputDL[i];
+      entry.bufferDepthUL = table.ulBufferDepth[i];
+      entry.waitingTimeUL = Now () - table.ulReportTime[i];
+      uint32_t mcs = rateControlIdeal (st);
+      entry.mcs = (mcs != HE_STATION_NO_MCS) ? mcs : 0;
+      m_snapshot.push_back (entry);
+    }
+}
+
+void
+RRMWifiManager::UpdateChangedQueues (void)
+{
+  NS_LOG_FUNCTION (this << m_stationTable.changedRows.size ());
+  HeStationTable &table = m_stationTable;
+  WifiMacHeader hdr;
+
+  for (std::vector<uint32_t>::const_iterator it = table.changedRows.begin (); it != table.changedRows.end (); it++)
+    {
+      uint32_t i = *it;
+      MacLowTransmissionListener *lt = table.listener[i];
+      Ptr<WifiMacQueue> queue = lt->GetQueue ();
+      table.needsAccess[i] = lt->NeedsAccess ();
+      table.bufferedBytes[i] = queue->GetBytes ();
+      table.holTimestamp[i] = lt->PeekFirstPacket (&hdr);
+      table.throughputDL[i] = queue->GetThroughput ();
+      table.queueChanged[i] = false;
+    }
+  table.changedRows.clear ();
+}
+
+void
+RRMWifiManager::NotifyQueueChanged (RRMWifiRemoteStation *st)
+{
+  if (st->m_tableIndex != HE_STATION_NO_ROW)
+    {
+      m_stationTable.MarkQueueChanged (st->m_tableIndex);
+    }
+}
+
+void
+RRMWifiManager::SetLastSnr (RRMWifiRemoteStation *st, double snr)
+{
+  if (st->m_tableIndex != HE_STATION_NO_ROW)
+    {
+      m_stationTable.lastSnr[st->m_tableIndex] = snr;
+    }
+}
+
+bool
+RRMWifiManager::CallSchedulerPlugin (bool isDownlink)
+{
+  NS_LOG_FUNCTION (this << isDownlink);
+  TakeStationSnapshot ();
+  m_assignments.clear ();
+  if (isDownlink)
+    {
+      m_scheduler->ScheduleDownlink (m_snapshot, m_assignments);
+    }
+  else
+    {
+      m_scheduler->ScheduleUplink (m_snapshot, m_assignments);
+    }
+  ValidateRuAssignments (m_assignments);
+  if (!ApplyRuAssignments (isDownlink, m_assignments))
+    {
+      return false;
+    }
+  CommitSchedule (isDownlink);
+  return true;
+}
+
+bool
+RRMWifiManager::CallSchedulerPlanner (bool isDownlink)
+{
+  NS_LOG_FUNCTION (this << isDownlink);
+  const HeStationTable &table = m_stationTable;
+
+  // A failed round flips the direction, the plan is then out of step
+  if (m_plan.empty () || m_plan.front ().isDownlink != isDownlink || IsPlanOutdated ())
+    {
+      if (!m_plan.empty ())
+        {
+          m_replans++;
+        }
+      PlanTxops (isDownlink);
+    }
+  m_plannedTxops++;
+  m_assignments.swap (m_plan.front ().assignments);
+  m_snapshot.swap (m_plan.front ().stations);
+  m_plan.pop_front ();
+  if (isDownlink)
+    {
+      // The projected backlog may have been optimistic
+      HeRuAssignmentList::iterator end = m_assignments.begin ();
+      for (HeRuAssignmentList::iterator it = m_assignments.begin (); it != m_assignments.end (); it++)
+        {
+          if (table.needsAccess[it->index])
+            {
+              *end++ = *it;
+            }
+        }
+      m_assignments.erase (end, m_assignments.end ());
+    }
+  if (!ApplyRuAssignments (isDownlink, m_assignments))
+    {
+      return false;
+    }
+  CommitSchedule (isDownlink);
+  return true;
+}
+
+void
+RRMWifiManager::ValidateRuAssignments (HeRuAssignmentList &assignments) const
+{
+  HeRuAssignmentList::iterator end = assignments.begin ();
+  for (HeRuAssignmentList::iterator it = assignments.begin (); it != assignments.end (); it++)
+    {
+      // The first AC_BE_NQOS rows are the broadcast queues
+      if (it->index < AC_BE_NQOS || it->index >= m_stationTable.GetN ())
+        {
+          NS_LOG_WARN ("Dropping the assignment of unknown station index " << it->index);
+          continue;
+        }
+      *end++ = *it;
+    }
+  assignments.erase (end, assignments.end ());
+}
+
+void
+RRMWifiManager::CommitSchedule (bool isDownlink)
+{
+  NS_LOG_FUNCTION (this << isDownlink);
+  if (isDownlink)
+    {
+      m_scheduler->CommitDownlink (m_snapshot, m_assignments);
+    }
+  else
+    {
+      m_scheduler->CommitUplink (m_snapshot, m_assignments);
+    }
+}
+
+void
+RRMWifiManager::PlanTxops (bool isDownlink)
+{
+  NS_LOG_FUNCTION (this << isDownlink);
+  const HeStationTable &table = m_stationTable;
+  const double ppduDuration = HE_MU_PPDU_DURATION.GetSeconds ();
+
+  TakeStationSnapshot ();
+  m_planBaseline.Take (table);
+  m_plan.clear ();
+  for (uint32_t k = 0; k < m_lookaheadTxops; k++, isDownlink = !isDownlink)
+    {
+      m_plan.push_back (PlannedTxop ());
+      PlannedTxop &txop = m_plan.back ();
+      txop.isDownlink = isDownlink;
+      txop.stations = m_snapshot;
+      if (isDownlink)
+        {
+          m_scheduler->ScheduleDownlink (m_snapshot, txop.assignments);
+        }
+      else
+        {
+          m_scheduler->ScheduleUplink (m_snapshot, txop.assignments);
+        }
+      ValidateRuAssignments (txop.assignments);
+      // Drain the snapshot by what the TXOP serves for the following ones
+      for (HeRuAssignmentList::const_iterator it = txop.assignments.begin (); it != txop.assignments.end (); it++)
+        {
+          HeStationSnapshot &entry = m_snapshot[it->index - AC_BE_NQOS];
+          uint32_t &depth = isDownlink ? entry.bufferDepthDL : entry.bufferDepthUL;
+          if (depth == 0xffffffff)
+            {
+              // A polled station is expected to report, count it as empty until it does
+              depth = 0;
+              continue;
+            }
+          double bytes = HEBitMap::GetHeDataRate (HEBitMap::GetRUTypeFromChannelWidth (it->chanW),
+                                                  it->mcs, 800, 1) * ppduDuration / 8;
+          depth -= static_cast<uint32_t> (std::min<double> (depth, bytes));
+          if (isDownlink)
+            {
+              entry.needsAccess = depth > 0;
+            }
+        }
+    }
+}
+
+bool
+RRMWifiManager::IsPlanOutdated (void) const
+{
+  return m_planBaseline.IsOutdated (m_stationTable, m_planSnrHysteresis);
+}
+
+double
+RRMWifiManager::GetReplanRate (void) const
+{
+  if (m_plannedTxops == 0)
+    {
+      return 0;
+    }
+  return static_cast<double> (m_replans.Get ()) / m_plannedTxops.Get ();
+}
+
 bool
 RRMWifiManager::StartTranmission (bool isDownlink, ServingStations servingStations)
 {
@@ -1199,7 +1683,7 @@ RRMWifiManager::StartTranmission (bool isDownlink, ServingStations servingStatio
 
     for(ServingStations::iterator it=servingStations.begin(); it != servingStations.end(); it++)
       {
-  	  uint16_t staAid = (*it)->m_aid;
+  	  uint16_t staAid = m_stationTable.aid[(*it)->m_tableIndex];
           ruInfoTx.index = (*it)->dataTxVector.GetRu();
   	  // We are going to serve these AIDs in this iteration
   	  ruInfoTx.m_aid = staAid;
@@ -1209,14 +1693,14 @@ RRMWifiManager::StartTranmission (bool isDownlink, ServingStations servingStatio
 
     if(isDownlink == false)
       {
- 	GetMac()->GetObject <RegularWifiMac> ()->GetMacLow ()->SendBasicTrigger(staMapTmp, MicroSeconds(5472));
+ 	GetMac()->GetObject <RegularWifiMac> ()->GetMacLow ()->SendBasicTrigger(staMapTmp, HE_MU_PPDU_DURATION);
       }
     else
       {
         //Send MU RTS and start CTS timer
 	GetMac()->GetObject <RegularWifiMac> ()->GetMacLow ()->SetOfdmaHeTransmit (true);
 	PrepareHeMuMpdu(servingStations);
-	GetMac()->GetObject <RegularWifiMac> ()->GetMacLow ()->SendMuRtsForPacket (MicroSeconds(5472*3));
+	GetMac()->GetObject <RegularWifiMac> ()->GetMacLow ()->SendMuRtsForPacket (3*HE_MU_PPDU_DURATION);
       }
     return true;
 }
@@ -1224,35 +1708,80 @@ RRMWifiManager::StartTranmission (bool isDownlink, ServingStations servingStatio
 uint32_t
 RRMWifiManager::FectchAxStationIndexFromMac(uint8_t mac[6], uint8_t trafficType)
 {
-  uint32_t   i, axIndex = 0;
-  uint32_t t_ac = 0;
-  uint8_t macAddr[6];
- 
-  memset(macAddr, '\0', sizeof(macAddr));
-  for (i = 0; i < m_axStations.size(); i++)
-  {
-      t_ac = QosUtilsMapTidToAc(m_axStations[i]->m_tid);
-      m_axStations[i]->m_state->m_address.CopyTo(macAddr);
-      if(memcmp(macAddr, mac, 6) == 0) { 
-          if(trafficType == AC_VO) {
-              if(t_ac == AC_VO) {
-                  axIndex = i;
-                  break; 
-              }
-          } else if(trafficType == AC_VI) {
-              if(t_ac == AC_VI) { 
-                  axIndex = i; 
-                  break; 
-              }
-          } else if(trafficType == AC_BE){
-              if(t_ac == AC_BE) { 
-                  axIndex = i; 
-                  break; 
-              }
-          }
-      } 
-  }
-  return axIndex;
+  uint64_t key = GetAxStationKey (mac, trafficType);
+  uint32_t mask = m_axStationSlots.size () - 1;
+  uint32_t slot;
+
+  if (m_axStationSlots.empty ())
+    {
+      return 0;
+    }
+  for (slot = (key * 0x9E3779B97F4A7C15ULL) >> 32; m_axStationSlots[slot & mask].key != 0; slot++)
+    {
+      if (m_axStationSlots[slot & mask].key == key)
+        {
+          return m_axStationSlots[slot & mask].index;
+        }
+    }
+  NS_LOG_DEBUG ("No queue for AC " << +trafficType << " of the station");
+  return 0;
+}
+
+uint64_t
+RRMWifiManager::GetAxStationKey (const uint8_t mac[6], uint8_t ac)
+{
+  uint64_t key = 0;
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      key = (key << 8) | mac[i];
+    }
+  // Keep 0 for the empty slots
+  return ((key << 8) | ac) + 1;
+}
+
+void
+RRMWifiManager::InsertAxStationSlot (uint64_t key, uint32_t index)
+{
+  uint32_t mask = m_axStationSlots.size () - 1;
+  uint32_t slot;
+
+  for (slot = (key * 0x9E3779B97F4A7C15ULL) >> 32; m_axStationSlots[slot & mask].key != 0; slot++)
+    {
+      if (m_axStationSlots[slot & mask].key == key)
+        {
+          // Keep the first queue registered for this (MAC, AC)
+          return;
+        }
+    }
+  m_axStationSlots[slot & mask].key = key;
+  m_axStationSlots[slot & mask].index = index;
+  m_axStationSlotsUsed++;
+}
+
+void
+RRMWifiManager::IndexAxStation (uint32_t index)
+{
+  RRMWifiRemoteStation *st = m_axStations[index];
+  uint8_t ac = QosUtilsMapTidToAc (st->m_tid);
+  uint8_t mac[6];
+
+  if (2 * (m_axStationSlotsUsed + 1) > m_axStationSlots.size ())
+    {
+      std::vector<AxStationSlot> old;
+      AxStationSlot empty = {0, 0};
+      old.swap (m_axStationSlots);
+      m_axStationSlots.assign (std::max<size_t> (64, 2 * old.size ()), empty);
+      m_axStationSlotsUsed = 0;
+      for (std::vector<AxStationSlot>::const_iterator it = old.begin (); it != old.end (); it++)
+        {
+          if (it->key != 0)
+            {
+              InsertAxStationSlot (it->key, it->index);
+            }
+        }
+    }
+  st->m_state->m_address.CopyTo (mac);
+  InsertAxStationSlot (GetAxStationKey (mac, ac), index);
 }
 
 int 
@@ -1569,8 +2098,6 @@ RRMWifiManager::EstablishRRMServerConnection()
 bool 
 RRMWifiManager::CallAlgoPlugin(bool isDownlink)
 {
-    int max_sd = 0;
-    fd_set readfds;
     TlvBuffer recvBuf;
     int  ret = 0;
     TlvBuffer* message = NULL;
@@ -1580,43 +2107,277 @@ RRMWifiManager::CallAlgoPlugin(bool isDownlink)
     
     //Setting the Indicator to activate 11ax RRM
     tlvEncode1Byte(message,TYPE_11AX_ACTIVATE_RRM,isDownlink) ;
-    write(m_sockId,(void*)message,sizeof(TlvBuffer));
+    bool sent = SendTlvMessage(m_sockId, message);
     free(message);
+    if(!sent)
+    {
+        return false;
+    }
 
     while(1)
     {
-        // init fd_set
-        FD_ZERO(&readfds); // to initialize socket descriptors
-        
-        FD_SET(m_sockId, &readfds); 
-        max_sd = (max_sd>m_sockId)?max_sd:m_sockId;
-        
-        ret = select(max_sd + 1, &readfds, NULL, NULL, NULL);
-        if (ret < 0)
+        sd = m_sockId ;
+        ret = ReceiveFromRrmServer(-1);
+        if(ret <= 0)
         {
-            printf("select failed\n ");
+            NS_LOG_ERROR("Connection to the RRM Server lost");
             return false;
         }
-        // warning: you don't know the max_sd value
-        sd = m_sockId ;
-        if (FD_ISSET(sd, &readfds)) 
+        // A read may carry part of a message or several of them
+        while((ret = tlvFrameReaderNext(&m_rrmReader, &recvBuf, IsRrmFramed())) == 1)
+        {
+            if(ProcessTlvMessage(&recvBuf, isDownlink) == 1) {
+                return 1;
+            }
+            memset(&recvBuf,0x00,sizeof(recvBuf));
+        }
+        if(ret < 0)
+        {
+            NS_LOG_ERROR("Malformed frame from the RRM Server");
+            tlvFrameReaderInit(&m_rrmReader);
+            return false;
+        }
+    }
+    return false;
+}
+
+bool
+RRMWifiManager::CallAlgoPluginAsync (bool isDownlink)
+{
+  NS_LOG_FUNCTION (this << isDownlink);
+  bool isScheduled = false;
+
+  if (m_rrmRoundPending)
+    {
+      isScheduled = PollRrmServer (isDownlink);
+    }
+  if (!isScheduled)
+    {
+      isScheduled = isDownlink ? SampleDLScheduler () : SampleULScheduler ();
+    }
+  if (!m_rrmRoundPending)
+    {
+      // ScheduleStations alternates directions, the next round is the other one
+      StartRrmRound (!isDownlink);
+    }
+  return isScheduled;
+}
+
+void
+RRMWifiManager::StartRrmRound (bool isDownlink)
+{
+  NS_LOG_FUNCTION (this << isDownlink);
+  TlvBuffer* message = (TlvBuffer*)malloc(sizeof(TlvBuffer));
+  memset(message,0x00,sizeof(TlvBuffer));
+  tlvEncode1Byte(message,TYPE_11AX_ACTIVATE_RRM,isDownlink);
+  bool sent = SendTlvMessage(m_sockId, message);
+  free(message);
+  m_rrmRounds++;
+  if (!sent)
+    {
+      // The round cannot start, the next access falls back again
+      m_rrmMissedRounds++;
+      return;
+    }
+
+  // Push the station snapshot along with the request, so that the server
+  // can work on this round while the simulation carries on. The fallback
+  // scheduler may just have dequeued packets, take the queues again.
+  UpdateChangedQueues ();
+  sd = m_sockId;
+  m_rrmStatsPushed = SendAllInfo(false) == 1;
+  m_rrmRoundPending = true;
+  m_rrmRoundExpired = false;
+  m_rrmRoundDownlink = isDownlink;
+  m_rrmRoundStart = std::chrono::steady_clock::now ();
+  m_rrmRoundSimStart = Simulator::Now ();
+}
+
+bool
+RRMWifiManager::PollRrmServer (bool isDownlink)
+{
+  NS_LOG_FUNCTION (this << isDownlink);
+  TlvBuffer recvBuf;
+  int ret = 0;
+  // A round started at this very simulation time had no chance to complete
+  bool mayWait = Simulator::Now () > m_rrmRoundSimStart;
+
+  if (!m_rrmRoundExpired && isDownlink != m_rrmRoundDownlink)
+    {
+      // The access the round was computed for went by without its results
+      NS_LOG_DEBUG ("RRM round " << m_rrmRounds << " missed its access");
+      m_rrmRoundExpired = true;
+      m_rrmMissedRounds++;
+    }
+  memset(&recvBuf,0x00,sizeof(recvBuf));
+  while (m_rrmRoundPending)
+    {
+      int64_t remainingUs = 0;
+      if (mayWait && !m_rrmRoundExpired)
         {
-            ret = recv(sd,(char *)&recvBuf,sizeof(TlvBuffer), 0);
-            if(ret > 0 )
+          std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now () - m_rrmRoundStart;
+          remainingUs = m_rrmDeadline.GetMicroSeconds ()
+            - std::chrono::duration_cast<std::chrono::microseconds> (elapsed).count ();
+          if (remainingUs <= 0)
             {
-                if(ProcessTlvMessage(&recvBuf, isDownlink) == 1) {
-                    return 1;
+              NS_LOG_DEBUG ("RRM server missed the deadline of round " << m_rrmRounds);
+              m_rrmRoundExpired = true;
+              m_rrmMissedRounds++;
+              remainingUs = 0;
+            }
+        }
+      sd = m_sockId;
+      ret = ReceiveFromRrmServer (remainingUs);
+      if (ret == 0)
+        {
+          // Nothing yet: either the deadline passed or we may not wait
+          return false;
+        }
+      if (ret < 0)
+        {
+          NS_LOG_ERROR("Connection to the RRM Server lost");
+          m_rrmRoundPending = false;
+          return false;
+        }
+      while (m_rrmRoundPending && (ret = tlvFrameReaderNext(&m_rrmReader, &recvBuf, IsRrmFramed ())) == 1)
+        {
+          m_rrmScheduled = false;
+          // HandleRRMResults drops the results of an expired round
+          if (ProcessTlvMessage(&recvBuf, isDownlink) == 1)
+            {
+              m_rrmRoundPending = false;
+              if (m_rrmRoundExpired)
+                {
+                  m_rrmLateRounds++;
                 }
-                memset(&recvBuf,0x00,sizeof(recvBuf));
             }
+          memset(&recvBuf,0x00,sizeof(recvBuf));
+        }
+      if (ret < 0)
+        {
+          NS_LOG_ERROR("Malformed frame from the RRM Server");
+          tlvFrameReaderInit(&m_rrmReader);
+          m_rrmRoundPending = false;
+          return false;
         }
     }
-    return false;
+  return m_rrmScheduled && !m_rrmRoundExpired;
+}
+
+bool
+RRMWifiManager::SendTlvMessage(int fd, TlvBuffer* message)
+{
+  int ret;
+
+  if (m_rrmTransport == RRM_TRANSPORT_SHM)
+    {
+      if (m_rrmShm == 0)
+        {
+          NS_LOG_ERROR ("Shared memory of the RRM Server is not attached");
+          return false;
+        }
+      // The server drains its ring concurrently, wait for room if it is
+      // full, but not for a stalled server
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+      while ((ret = rrmShmWriteFrame (&m_rrmShm->toServer, message)) == 0)
+        {
+          if (std::chrono::steady_clock::now () - start >= std::chrono::microseconds (m_rrmDeadline.GetMicroSeconds ()))
+            {
+              NS_LOG_ERROR ("RRM Server ring full for " << m_rrmDeadline << ", message dropped");
+              return false;
+            }
+          sched_yield ();
+        }
+    }
+  else
+    {
+      ret = tlvWriteFrame(fd, message, m_framedTlv);
+    }
+  if (ret < 0)
+    {
+      NS_LOG_ERROR ("Write to the RRM Server failed");
+      return false;
+    }
+  m_rrmTxBytes += ret;
+  return true;
+}
+
+bool
+RRMWifiManager::IsRrmFramed (void) const
+{
+  return m_framedTlv || m_rrmTransport == RRM_TRANSPORT_SHM;
+}
+
+int
+RRMWifiManager::ReceiveFromRrmServer (int64_t timeoutUs)
+{
+  int ret;
+
+  if (m_rrmTransport == RRM_TRANSPORT_SHM)
+    {
+      if (m_rrmShm == 0)
+        {
+          return -1;
+        }
+      // No descriptor to block on: poll the ring, yielding to the server
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+      while ((ret = rrmShmFrameReaderFill (&m_rrmReader, &m_rrmShm->toClient)) == 0)
+        {
+          if (timeoutUs >= 0
+              && std::chrono::steady_clock::now () - start >= std::chrono::microseconds (timeoutUs))
+            {
+              return 0;
+            }
+          sched_yield ();
+        }
+      return ret;
+    }
+
+  fd_set readfds;
+  struct timeval timeout;
+  FD_ZERO(&readfds);
+  FD_SET(m_sockId, &readfds);
+  timeout.tv_sec = timeoutUs / 1000000;
+  timeout.tv_usec = timeoutUs % 1000000;
+  ret = select(m_sockId + 1, &readfds, NULL, NULL, timeoutUs < 0 ? NULL : &timeout);
+  if (ret < 0)
+    {
+      NS_LOG_ERROR ("select failed");
+      return -1;
+    }
+  if (ret == 0)
+    {
+      return 0;
+    }
+  ret = tlvFrameReaderFill(&m_rrmReader, m_sockId);
+  return ret > 0 ? ret : -1;
+}
+
+int
+RRMWifiManager::AttachRrmShm (void)
+{
+  NS_LOG_FUNCTION (this << m_rrmShmName);
+  if (m_rrmShm == 0)
+    {
+      m_rrmShm = rrmShmAttach (m_rrmShmName.c_str ());
+    }
+  if (m_rrmShm == 0)
+    {
+      NS_LOG_DEBUG ("Shared memory of the RRM Server not found: " << m_rrmShmName);
+      return -1;
+    }
+  return 1;
 }
 
 void
 RRMWifiManager::rateControlDataSuccess (RRMWifiRemoteStation *st)
 {
+  // Only the queues of the scheduler have an MCS
+  if (st->m_tableIndex == HE_STATION_NO_ROW)
+    {
+      return;
+    }
+  int32_t &mcs = m_stationTable.mcs[st->m_tableIndex];
   if (m_rateControlSelector == ARF)
     {
       st->m_failed = 0;
@@ -1624,10 +2385,10 @@ RRMWifiManager::rateControlDataSuccess (RRMWifiRemoteStation *st)
       if (st->m_success > st->m_arfSuccessThreshold)
       {
         st->m_success = 0;
-        st->m_mcsVal++;
+        mcs++;
       }
-      if (st->m_mcsVal > 11)
-        st->m_mcsVal = 11;
+      if (mcs > 11)
+        mcs = 11;
     }
   else if (m_rateControlSelector == AARF)
     {
@@ -1639,34 +2400,39 @@ RRMWifiManager::rateControlDataSuccess (RRMWifiRemoteStation *st)
       NS_LOG_DEBUG ("station=" << st << " data ok success=" << st->m_success << ", timer=" << st->m_timer);
       if ((st->m_success == st->m_successThreshold
            || st->m_timer == st->m_timerTimeout)
-          && (st->m_mcsVal < 11))
+          && (mcs < 11))
         {
           NS_LOG_DEBUG ("station=" << st << " inc rate");
-          st->m_mcsVal++;
+          mcs++;
           st->m_timer = 0;
           st->m_success = 0;
           st->m_recovery = true;
         }
-      if (st->m_mcsVal > 11)
-        st->m_mcsVal = 11;
+      if (mcs > 11)
+        mcs = 11;
     }
-  NS_LOG_DEBUG("Mcs Value for station " << st->m_aid << " is : " << st->m_mcsVal << " DoReportDataOk");
+  NS_LOG_DEBUG("Mcs Value for station " << m_stationTable.aid[st->m_tableIndex] << " is : " << mcs << " DoReportDataOk");
 }
 
 void
 RRMWifiManager::rateControlDataFailed (RRMWifiRemoteStation *st)
 {
+  if (st->m_tableIndex == HE_STATION_NO_ROW)
+    {
+      return;
+    }
+  int32_t &mcs = m_stationTable.mcs[st->m_tableIndex];
   if (m_rateControlSelector == ARF)
     {
       st->m_failed++;
       st->m_success = 0;
-      st->m_mcsVal--;
-      if(st->m_mcsVal < 0)
-      st->m_mcsVal = 0;
+      mcs--;
+      if(mcs < 0)
+      mcs = 0;
       if (st->m_failed > st->m_arfFailureThreshold)
         {
           st->m_failed = 0;
-          st->m_mcsVal = 0;
+          mcs = 0;
         }
     }
   else if (m_rateControlSelector == AARF)
@@ -1684,9 +2450,9 @@ RRMWifiManager::rateControlDataFailed (RRMWifiRemoteStation *st)
               //need recovery fallback
               st->m_successThreshold = (st->m_successThreshold * m_successK < m_maxSuccessThreshold) ? (int)(st->m_successThreshold * m_successK) : m_maxSuccessThreshold;
               st->m_timerTimeout = (st->m_timerTimeout * m_timerK > m_minSuccessThreshold) ? (int)(st->m_timerTimeout * m_timerK) : m_minSuccessThreshold;
-              if (st->m_mcsVal != 0)
+              if (mcs != 0)
                 {
-                  st->m_mcsVal--;
+                  mcs--;
                 }
             }
           st->m_timer = 0;
@@ -1699,9 +2465,9 @@ RRMWifiManager::rateControlDataFailed (RRMWifiRemoteStation *st)
               //need normal fallback
               st->m_timerTimeout = m_minTimerThreshold;
               st->m_successThreshold = m_minSuccessThreshold;
-              if (st->m_mcsVal != 0)
+              if (mcs != 0)
                 {
-                  st->m_mcsVal--;
+                  mcs--;
                 }
             }
           if (st->m_retry >= 2)
@@ -1710,7 +2476,7 @@ RRMWifiManager::rateControlDataFailed (RRMWifiRemoteStation *st)
             }
         }
     }
-  NS_LOG_DEBUG("Mcs Value for station " << st->m_aid << " is : " << st->m_mcsVal << " DoReportDataFailed");
+  NS_LOG_DEBUG("Mcs Value for station " << m_stationTable.aid[st->m_tableIndex] << " is : " << mcs << " DoReportDataFailed");
 }
 
 void
@@ -1746,6 +2512,9 @@ RRMWifiManager::GetSnrThreshold (WifiTxVector txVector) const
 uint32_t
 RRMWifiManager::rateControlIdeal(RRMWifiRemoteStation *station)
 {
+  NS_ASSERT (station->m_tableIndex != HE_STATION_NO_ROW);
+  int32_t &mcs = m_stationTable.mcs[station->m_tableIndex];
+  double lastSnr = m_stationTable.lastSnr[station->m_tableIndex];
   if (m_rateControlSelector == IDEAL)
     {
       WifiMode maxMode = m_wifiPhy->GetHeMcs (0);
@@ -1755,19 +2524,20 @@ RRMWifiManager::rateControlIdeal(RRMWifiRemoteStation *station)
       uint8_t channelWidth = std::min (GetChannelWidth (station), GetPhy ()->GetChannelWidth ());
       txVector.SetChannelWidth (channelWidth);
       txVector.SetNss (1);
+      int ruType = HEBitMap::GetRUTypeFromChannelWidth (channelWidth);
 
-      if (station->m_lastSnrCached != CACHE_INITIAL_VALUE && station->m_lastSnrObserved == station->m_lastSnrCached)
+      if (station->m_lastSnrCached != CACHE_INITIAL_VALUE && lastSnr == station->m_lastSnrCached)
         {
           // SNR has not changed, so skip the search and use the last
           // mode selected
 
           NS_LOG_DEBUG ("Using cached mode = " << maxMode.GetUniqueName () <<
-                        " last snr observed " << station->m_lastSnrObserved <<
+                        " last snr observed " << lastSnr <<
                         " cached " << station->m_lastSnrCached);
 
-          return station->m_mcsVal;
+          return mcs;
         }
-      else if (station->m_lastSnrObserved != 0)
+      else if (lastSnr != 0)
         {
           // HE selection
           for (uint32_t i = 0; i < m_wifiPhy->GetNMcs(); i++)
@@ -1779,32 +2549,34 @@ RRMWifiManager::rateControlIdeal(RRMWifiRemoteStation *station)
                 }
               txVector.SetMode (mode);
               double threshold = GetSnrThreshold (txVector);
-              uint64_t dataRate = mode.GetDataRate (txVector);
+              // Widths with no HE RU, e.g. 5, 10 or 22 MHz, keep the PHY rates
+              uint64_t dataRate = ruType ? HEBitMap::GetHeDataRate (ruType, mode.GetMcsValue (), 800, txVector.GetNss ())
+                                         : mode.GetDataRate (txVector);
               NS_LOG_DEBUG ("mode = " << mode.GetUniqueName () <<
                             " threshold " << threshold  <<
                             " last snr observed " <<
-                            station->m_lastSnrObserved);
-              if (dataRate > bestRate && threshold < station->m_lastSnrObserved)
+                            lastSnr);
+              if (dataRate > bestRate && threshold < lastSnr)
                 {
                   NS_LOG_DEBUG ("Candidate mode = " << mode.GetUniqueName () <<
                                 " data rate " << dataRate <<
                                 " threshold " << threshold  <<
                                 " last snr observed " <<
-                                station->m_lastSnrObserved);
+                                lastSnr);
                   bestRate = dataRate;
                   maxMode = mode;
                 }
             }
 	}
-      station->m_lastSnrCached = station->m_lastSnrObserved;
-      station->m_mcsVal = maxMode.GetMcsValue();
-      NS_LOG_DEBUG("Best mcs chosen is : " << +station->m_mcsVal);
-      return station->m_mcsVal;
+      station->m_lastSnrCached = lastSnr;
+      mcs = maxMode.GetMcsValue();
+      NS_LOG_DEBUG("Best mcs chosen is : " << +mcs);
+      return mcs;
     }
   else
     {
-      NS_LOG_DEBUG("MCS chosen by ARF/AARF  is : " << +station->m_mcsVal);
-      return station->m_mcsVal;
+      NS_LOG_DEBUG("MCS chosen by ARF/AARF  is : " << +mcs);
+      return mcs;
     }
 }
 
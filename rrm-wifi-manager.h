@@ -40,14 +40,18 @@
 
 #include <stdint.h>
 #include <vector>
+#include <deque>
 #include "ns3/traced-value.h"
 #include "ns3/he-bitmap.h"
+#include "ns3/he-scheduler-plugin.h"
 #include "wifi-mode.h"
 #include "wifi-remote-station-manager.h"
 #include "mac-low.h"
 #include <iostream>
 #include <fstream>
+#include <chrono>
 #include "tlv.h"
+#include "rrm-shm-ring.h"
 
 namespace ns3 {
 
@@ -58,11 +62,82 @@ enum RateControlAlgorithm
    IDEAL = 2
 };
 
-typedef struct
+enum RrmTransport
 {
-  uint32_t  bufLen;  // Buffer in 256 octets
-  Time      time;    // time stamp
-} BufferStats;
+   RRM_TRANSPORT_TCP = 0,
+   RRM_TRANSPORT_SHM = 1
+};
+
+#define HE_STATION_NO_ROW 0xffffffff
+#define HE_STATION_NO_MCS 0xff
+
+/**
+ * \brief State of the HE station queues
+ *
+ * One column per field, row i describing RRMWifiManager::m_axStations[i],
+ * so that the scheduling loops and SendAllInfo scan contiguous arrays
+ * instead of dereferencing every station and its MacLow listener. The
+ * station objects only hold their row index; the buffer status, rate
+ * control and SNR reports write their row as they come. The DL queue is
+ * owned by the listener and changes after the notifications of the
+ * manager (enqueue, MU dequeue, transmission status), so these mark the
+ * row, and only the marked rows are read back before a scheduling round.
+ */
+struct HeStationTable
+{
+  std::vector<uint16_t> aid;            //!< Association ID
+  std::vector<uint8_t> ac;              //!< Access category of the queue
+  std::vector<MacLowTransmissionListener *> listener; //!< DL queue of the AC
+  std::vector<uint8_t> needsAccess;     //!< The DL queue has a packet to send
+  std::vector<uint32_t> bufferedBytes;  //!< DL queue depth in bytes
+  std::vector<Time> holTimestamp;       //!< Enqueue time of the DL head of line packet
+  std::vector<double> throughputDL;     //!< DL queue throughput
+  std::vector<uint32_t> ulBufferDepth;  //!< Last UL buffer status in bytes, 0xffffffff if unknown or stale
+  std::vector<Time> ulReportTime;       //!< Time of the last UL buffer status report
+  std::vector<int32_t> mcs;             //!< MCS of the rate control, HE_STATION_NO_MCS until it selects one
+  std::vector<double> lastSnr;          //!< SNR of the last frame exchanged with the station, 0 if none
+  std::vector<uint8_t> queueChanged;    //!< The DL queue changed since the row was read
+  std::vector<uint32_t> changedRows;    //!< Rows with queueChanged set
+
+  /**
+   * Append the row of a new queue, marked as changed
+   * \return the row index
+   */
+  uint32_t Add (uint16_t aid, uint8_t ac, MacLowTransmissionListener *lt);
+  uint32_t GetN (void) const;
+  /**
+   * Mark the DL queue of a row as changed
+   */
+  void MarkQueueChanged (uint32_t row);
+};
+
+/**
+ * \brief State of the HeStationTable rows a lookahead plan was computed from
+ *
+ * A plan stays valid while the queues only drain. A new or grown backlog,
+ * or a change of the link quality a rate control would react to, makes it
+ * out of date. The link quality is followed through the SNR rather than
+ * the MCS column, which the IDEAL rate control only writes when a snapshot
+ * is taken and the ARF ones rewrite on every frame.
+ */
+struct HePlanBaseline
+{
+  std::vector<uint32_t> bufferedBytes;  //!< DL queue depth in bytes
+  std::vector<uint32_t> ulBufferDepth;  //!< UL buffer status in bytes, 0xffffffff if unknown or stale
+  std::vector<double> lastSnr;          //!< SNR of the last frame exchanged with the station, 0 if none
+
+  /**
+   * Record the current state of the table
+   */
+  void Take (const HeStationTable &table);
+  /**
+   * \param table the station table
+   * \param snrHysteresis SNR change in dB above which the plan is out of date
+   * \return true if a queue, buffer status report or SNR changed since
+   *         Take in a way the plan did not account for
+   */
+  bool IsOutdated (const HeStationTable &table, double snrHysteresis) const;
+};
 
 /**
  * \brief hold per-remote-station state for RRM Wifi manager.
@@ -72,12 +147,9 @@ typedef struct
  */
 struct RRMWifiRemoteStation : public WifiRemoteStation
 {
-  uint16_t m_aid;
-  MacLowTransmissionListener *lt;
   WifiTxVector      dataTxVector;
 
-  //Buffer stats of stations (UL)
-  BufferStats       ulBufferStat;
+  uint32_t          m_tableIndex;       //!< Row in HeStationTable, HE_STATION_NO_ROW if the queue is not scheduled
   EventId           ulBSStaleTimer;
   uint32_t          m_timer;
   uint32_t          m_success;
@@ -86,8 +158,6 @@ struct RRMWifiRemoteStation : public WifiRemoteStation
   uint32_t          m_retry;
   uint32_t          m_timerTimeout;
   uint32_t          m_successThreshold;
-  int32_t           m_mcsVal;
-  double            m_lastSnrObserved;  //!< SNR of most recently reported packet sent to the remote station
   double            m_lastSnrCached;    //!< SNR most recently used to select a rate
   uint32_t          m_arfSuccessThreshold;
   uint32_t          m_arfFailureThreshold;
@@ -113,6 +183,13 @@ public:
   void SetSiMax (Time siMax);
   Time GetSiMin (void) const;
   Time GetSiMax (void) const;
+  void SetSchedulerPluginType (std::string type);
+  std::string GetSchedulerPluginType (void) const;
+  /**
+   * \return the fraction of the TXOPs scheduled by the lookahead planner
+   *         that discarded the rest of a plan, 0 before the first TXOP
+   */
+  double GetReplanRate (void) const;
 
   int tlvWriteTypeLen(TlvBuffer* buf,short type,short len);
   int tlvEncode1Byte(TlvBuffer* buf,short type,char val);
@@ -155,6 +232,31 @@ public:
   void PrintCurrentTime(void);
   int ProcessTlvMessage(TlvBuffer* message, bool isDownlink);
   int initSocket(int* socketfd);
+  /**
+   * Send a message to the RRM server, framed according to the FramedTlv attribute
+   *
+   * \return false if the message was not sent, e.g. because the shared
+   *         memory ring to the server stayed full for RrmDeadline
+   */
+  bool SendTlvMessage(int fd, TlvBuffer* message);
+  /**
+   * \return true if the messages exchanged with the RRM server are length
+   *         prefixed frames, always the case over shared memory
+   */
+  bool IsRrmFramed (void) const;
+  /**
+   * Wait for data from the RRM server and append it to m_rrmReader
+   *
+   * \param timeoutUs wall clock time to wait in microseconds, -1 to wait
+   *        until data arrives
+   * \return the number of bytes received, 0 on timeout, -1 if the RRM
+   *         server cannot be reached
+   */
+  int ReceiveFromRrmServer (int64_t timeoutUs);
+  /**
+   * Map the shared memory segment created by the RRM server
+   */
+  int AttachRrmShm (void);
 
 private:
   class Dcf;
@@ -231,9 +333,78 @@ private:
    */
   int EstablishRRMServerConnection();
   bool CallAlgoPlugin(bool isDownlink);
+  /**
+   * Pipelined exchange with the RRM server: consume the results of the
+   * pending round if they arrive before the RrmDeadline, fall back to the
+   * sample schedulers otherwise, and start the next round.
+   */
+  bool CallAlgoPluginAsync (bool isDownlink);
+  /**
+   * Send the request and the station snapshot of a new round to the RRM server
+   */
+  void StartRrmRound (bool isDownlink);
+  /**
+   * Process the messages of the RRM server until the pending round
+   * completes or its deadline expires. A round started for the other
+   * direction expires at once. The answer of an expired round is drained
+   * and counted as late, but never applied.
+   *
+   * \param isDownlink direction of the current access
+   * \return true if the results of the round started a transmission
+   */
+  bool PollRrmServer (bool isDownlink);
+  /**
+   * Run one scheduling round with the in-process scheduler plugin
+   */
+  bool CallSchedulerPlugin (bool isDownlink);
+  /**
+   * Run one scheduling round from the plan of the next LookaheadTxops
+   * TXOPs, planning again if it is exhausted or out of date
+   */
+  bool CallSchedulerPlanner (bool isDownlink);
+  /**
+   * Plan the next LookaheadTxops TXOPs with the in-process scheduler,
+   * alternating directions from the given one
+   */
+  void PlanTxops (bool isDownlink);
+  /**
+   * Drop the assignments of a scheduler plugin whose index is not a
+   * station row of m_stationTable
+   */
+  void ValidateRuAssignments (HeRuAssignmentList &assignments) const;
+  /**
+   * Commit the assignments of the round to the scheduler plugin, together
+   * with the snapshot they were planned from
+   */
+  void CommitSchedule (bool isDownlink);
+  /**
+   * \return true if a queue, buffer status report or SNR changed since
+   *         the plan was computed in a way the plan did not account for
+   */
+  bool IsPlanOutdated (void) const;
+  /**
+   * Fill m_snapshot with the state of every HE station queue
+   */
+  void TakeStationSnapshot (void);
+  /**
+   * Read back the DL queue of the rows marked as changed in m_stationTable
+   */
+  void UpdateChangedQueues (void);
+  /**
+   * Mark the DL queue of a station as changed, if it has a row
+   */
+  void NotifyQueueChanged (RRMWifiRemoteStation *st);
+  /**
+   * Record the SNR of the last frame exchanged with a station, if it has a row
+   */
+  void SetLastSnr (RRMWifiRemoteStation *st, double snr);
  
   typedef std::vector <RRMWifiRemoteStation *> AxStations;
   typedef std::vector<RRMWifiRemoteStation *> ServingStations;
+  /**
+   * Set the TX vectors of the assigned stations and start the HE MU transmission
+   */
+  bool ApplyRuAssignments (bool isDownlink, const HeRuAssignmentList &assignments);
   /**
    *
    */
@@ -243,9 +414,18 @@ private:
    */
   void PrepareHeMuMpdu(ServingStations servingStations);
   /**
-   *
+   * \return the m_axStations index of the (station, AC) queue, 0 if unknown
    */
   uint32_t FectchAxStationIndexFromMac(uint8_t mac[6], uint8_t trafficType);
+  /**
+   * Add m_axStations[index] to the (MAC, AC) index
+   */
+  void IndexAxStation (uint32_t index);
+  /**
+   * Insert key in m_axStationSlots unless present, the table must have a free slot
+   */
+  void InsertAxStationSlot (uint64_t key, uint32_t index);
+  static uint64_t GetAxStationKey (const uint8_t mac[6], uint8_t ac);
   /**
    * make the UL buffer status invalid if the stale timer expired
    */
@@ -296,6 +476,17 @@ private:
    * A vector of WifiRemoteStations
    */
   AxStations m_axStations;                  //!< Information for each known stations
+  HeStationTable m_stationTable;            //!< Scheduler state of m_axStations, same indexes
+  /**
+   * Slot of the open addressing (MAC, AC) index of m_axStations
+   */
+  struct AxStationSlot
+  {
+    uint64_t key;                           //!< GetAxStationKey, 0 for an empty slot
+    uint32_t index;                         //!< m_axStations index
+  };
+  std::vector<AxStationSlot> m_axStationSlots; //!< Linear probing table, power of two size, at most half full
+  uint32_t m_axStationSlotsUsed;            //!< Occupied slots
   WifiMode m_dataMode; //!< Wifi mode for unicast DATA frames
   WifiMode m_ctlMode;  //!< Wifi mode for RTS frames
 
@@ -310,6 +501,24 @@ private:
   * Socket Communication between ns3 and RRM Server
   */
   int m_sockId; //Socket to communicate betweeen ns3 and RRM Server Module
+  bool m_framedTlv;                   //!< Length prefixed frames instead of whole TlvBuffers
+  TlvFrameReader m_rrmReader;         //!< Reassembles the messages received from the RRM Server
+  RrmTransport m_rrmTransport;        //!< TCP socket or shared memory rings
+  std::string m_rrmShmName;           //!< POSIX shared memory object of the RRM Server
+  RrmShmSegment *m_rrmShm;            //!< Mapped rings, 0 until attached
+  TracedValue<uint64_t> m_rrmTxBytes; //!< Bytes sent to the RRM Server
+  bool m_rrmAsync;                    //!< Pipelined exchange with the RRM Server
+  Time m_rrmDeadline;                 //!< Wall clock deadline of an asynchronous round
+  bool m_rrmRoundPending;             //!< A round has been sent and its results are awaited
+  bool m_rrmRoundExpired;             //!< The pending round missed its deadline or its access
+  bool m_rrmStatsPushed;              //!< The snapshot of the pending round was sent unasked
+  bool m_rrmRoundDownlink;            //!< Direction of the pending round
+  bool m_rrmScheduled;                //!< The last RRM results started a transmission
+  std::chrono::steady_clock::time_point m_rrmRoundStart; //!< Wall clock start of the pending round
+  Time m_rrmRoundSimStart;            //!< Simulation time at which the pending round started
+  uint32_t m_rrmRounds;               //!< Asynchronous rounds started
+  TracedValue<uint32_t> m_rrmMissedRounds; //!< Rounds that fell back to the sample schedulers
+  TracedValue<uint32_t> m_rrmLateRounds;   //!< Rounds whose results arrived after the deadline
 
   uint32_t m_minTimerThreshold;
   uint32_t m_minSuccessThreshold;
@@ -327,6 +536,27 @@ private:
   double m_ber;             //!< The maximum Bit Error Rate acceptable at any transmission mode
   Thresholds m_thresholds;  //!< List of WifiTxVector and the minimum SNR pair
   bool m_SchedulerPluginEnabled;
+  std::string m_schedulerPluginType;   //!< TypeId name of the in-process scheduler, empty for the RRM server
+  Ptr<HeSchedulerPlugin> m_scheduler;  //!< In-process scheduler
+  HeStationSnapshotList m_snapshot;    //!< Station snapshot handed to the scheduler, reused across rounds
+  HeRuAssignmentList m_assignments;    //!< Scheduler output, reused across rounds
+  bool m_nextScheduleUplink;           //!< Direction of the next round
+
+  /**
+   * One TXOP of the lookahead plan
+   */
+  struct PlannedTxop
+  {
+    bool isDownlink;                   //!< Direction of the TXOP
+    HeStationSnapshotList stations;    //!< Projected snapshot the TXOP was planned from
+    HeRuAssignmentList assignments;    //!< Scheduler output for the TXOP
+  };
+  uint32_t m_lookaheadTxops;           //!< TXOPs planned at once, 1 to schedule each TXOP on its own
+  std::deque<PlannedTxop> m_plan;      //!< TXOPs left in the current plan
+  HePlanBaseline m_planBaseline;       //!< Table state the plan was computed from
+  double m_planSnrHysteresis;          //!< SNR change in dB which makes a plan out of date
+  TracedValue<uint32_t> m_plannedTxops; //!< TXOPs scheduled by the planner
+  TracedValue<uint32_t> m_replans;     //!< Plans discarded before their last TXOP
 };
 
 }
@@ -0,0 +1,342 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#include <cmath>
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/qos-utils.h"
+#include "ns3/he-pf-scheduler.h"
+#include "ns3/he-bsr-ul-scheduler.h"
+#include "ns3/he-edf-scheduler.h"
+#include "ns3/rrm-wifi-manager.h"
+
+using namespace ns3;
+
+/**
+ * HePfScheduler exposing its average throughputs
+ */
+class HePfSchedulerProbe : public HePfScheduler
+{
+public:
+  double GetAverageDL (uint16_t aid) const
+  {
+    return GetAverage (m_averageDL, aid);
+  }
+  double GetAverageUL (uint16_t aid) const
+  {
+    return GetAverage (m_averageUL, aid);
+  }
+};
+
+/**
+ * \return a BE queue of the given station, with DL and UL backlogs
+ */
+static HeStationSnapshot
+MakeStation (uint32_t index, uint16_t aid, uint32_t bufferDepthDL, uint32_t bufferDepthUL)
+{
+  HeStationSnapshot entry;
+  entry.index = index;
+  entry.aid = aid;
+  entry.ac = AC_BE;
+  entry.needsAccess = bufferDepthDL > 0;
+  entry.bufferDepthDL = bufferDepthDL;
+  entry.waitingTimeDL = Seconds (0);
+  entry.throughputDL = 0;
+  entry.bufferDepthUL = bufferDepthUL;
+  entry.waitingTimeUL = Seconds (0);
+  entry.mcs = 5;
+  return entry;
+}
+
+/**
+ * Planning with HePfScheduler leaves the average throughputs unchanged
+ * until the round is committed
+ */
+class HePfSchedulerPlanTestCase : public TestCase
+{
+public:
+  HePfSchedulerPlanTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+HePfSchedulerPlanTestCase::HePfSchedulerPlanTestCase ()
+  : TestCase ("Discarded PF plans leave the average throughputs unchanged")
+{
+}
+
+void
+HePfSchedulerPlanTestCase::DoRun (void)
+{
+  Ptr<HePfSchedulerProbe> scheduler = CreateObject<HePfSchedulerProbe> ();
+  HeStationSnapshotList stations;
+  HeRuAssignmentList assignments;
+  HeRuAssignmentList discarded;
+
+  stations.push_back (MakeStation (4, 1, 20000, 20000));
+  stations.push_back (MakeStation (8, 2, 20000, 20000));
+
+  // Plans computed and thrown away, as on a replan
+  scheduler->ScheduleDownlink (stations, discarded);
+  scheduler->ScheduleUplink (stations, discarded);
+  scheduler->ScheduleDownlink (stations, assignments);
+  NS_TEST_ASSERT_MSG_EQ (assignments.empty (), false, "No station scheduled");
+  for (uint16_t aid = 1; aid <= 2; aid++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (scheduler->GetAverageDL (aid), 0, "DL average changed by planning");
+      NS_TEST_ASSERT_MSG_EQ (scheduler->GetAverageUL (aid), 0, "UL average changed by planning");
+    }
+
+  // The same snapshot plans the same round
+  scheduler->ScheduleDownlink (stations, discarded);
+  NS_TEST_ASSERT_MSG_EQ (discarded.size (), assignments.size (), "Planning is not repeatable");
+
+  scheduler->CommitDownlink (stations, assignments);
+  NS_TEST_ASSERT_MSG_GT (scheduler->GetAverageDL (stations[0].aid) + scheduler->GetAverageDL (stations[1].aid),
+                         0, "DL average not credited on commit");
+  NS_TEST_ASSERT_MSG_EQ (scheduler->GetAverageUL (1) + scheduler->GetAverageUL (2), 0,
+                         "UL average changed by a DL commit");
+}
+
+/**
+ * Polls planned by HeBsrUlScheduler are only counted, and only delay the
+ * next poll of a station, once committed
+ */
+class HeBsrUlSchedulerPlanTestCase : public TestCase
+{
+public:
+  HeBsrUlSchedulerPlanTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Run the checks once the poll interval has elapsed
+   */
+  void CheckPolls (void);
+  /**
+   * Polls trace sink
+   */
+  void NotifyPolls (uint32_t oldValue, uint32_t newValue);
+
+  uint32_t m_polls;                       //!< Last value of the Polls trace
+};
+
+HeBsrUlSchedulerPlanTestCase::HeBsrUlSchedulerPlanTestCase ()
+  : TestCase ("Discarded BSR plans leave the poll counters unchanged"),
+    m_polls (0)
+{
+}
+
+void
+HeBsrUlSchedulerPlanTestCase::NotifyPolls (uint32_t oldValue, uint32_t newValue)
+{
+  m_polls = newValue;
+}
+
+void
+HeBsrUlSchedulerPlanTestCase::CheckPolls (void)
+{
+  Ptr<HeBsrUlScheduler> scheduler = CreateObject<HeBsrUlScheduler> ();
+  HeStationSnapshotList stations;
+  HeRuAssignmentList assignments;
+  HeRuAssignmentList discarded;
+
+  scheduler->TraceConnectWithoutContext ("Polls", MakeCallback (&HeBsrUlSchedulerPlanTestCase::NotifyPolls, this));
+  // Two stations which never reported their buffer status
+  stations.push_back (MakeStation (4, 1, 0, 0xffffffff));
+  stations.push_back (MakeStation (8, 2, 0, 0xffffffff));
+
+  scheduler->ScheduleUplink (stations, discarded);
+  NS_TEST_ASSERT_MSG_EQ (discarded.size (), 2, "Stale stations not polled");
+  scheduler->ScheduleUplink (stations, assignments);
+  NS_TEST_ASSERT_MSG_EQ (assignments.size (), 2, "A discarded poll delayed the next one");
+  NS_TEST_ASSERT_MSG_EQ (m_polls, 0, "Polls counted by planning");
+
+  scheduler->CommitUplink (stations, assignments);
+  NS_TEST_ASSERT_MSG_EQ (m_polls, 2, "Committed polls not counted");
+  scheduler->ScheduleUplink (stations, assignments);
+  NS_TEST_ASSERT_MSG_EQ (assignments.empty (), true, "Station polled again within the poll interval");
+}
+
+void
+HeBsrUlSchedulerPlanTestCase::DoRun (void)
+{
+  // A station is only due for a poll PollInterval after the start
+  Simulator::Schedule (Seconds (1), &HeBsrUlSchedulerPlanTestCase::CheckPolls, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+/**
+ * HeEdfScheduler serves a station for its most urgent VO or VI queue, not
+ * for its highest priority one
+ */
+class HeEdfSchedulerTestCase : public TestCase
+{
+public:
+  HeEdfSchedulerTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+HeEdfSchedulerTestCase::HeEdfSchedulerTestCase ()
+  : TestCase ("EDF serves the queue with the earliest deadline of a station")
+{
+}
+
+void
+HeEdfSchedulerTestCase::DoRun (void)
+{
+  Ptr<HeEdfScheduler> scheduler = CreateObject<HeEdfScheduler> ();
+  HeStationSnapshotList stations;
+  HeRuAssignmentList assignments;
+
+  // Station 1 has a fresh VO queue and a VI queue 10 ms from its deadline
+  stations.push_back (MakeStation (4, 1, 3000, 0));
+  stations.back ().ac = AC_VO;
+  stations.back ().waitingTimeDL = MilliSeconds (1);
+  stations.push_back (MakeStation (5, 1, 3000, 0));
+  stations.back ().ac = AC_VI;
+  stations.back ().waitingTimeDL = MilliSeconds (90);
+  for (uint16_t aid = 2; aid < 10; aid++)
+    {
+      stations.push_back (MakeStation (4 * aid, aid, 90000, 0));
+    }
+
+  scheduler->ScheduleDownlink (stations, assignments);
+  bool servedVi = false;
+  for (HeRuAssignmentList::const_iterator it = assignments.begin (); it != assignments.end (); it++)
+    {
+      NS_TEST_ASSERT_MSG_NE (it->index, 4, "Station served for its VO queue");
+      servedVi |= it->index == 5;
+    }
+  NS_TEST_ASSERT_MSG_EQ (servedVi, true, "Urgent VI queue not served");
+}
+
+/**
+ * A lookahead plan is out of date when a queue grows or the SNR of a
+ * station moves by more than the hysteresis, whatever the rate control
+ * does with the MCS column
+ */
+class HePlanBaselineTestCase : public TestCase
+{
+public:
+  HePlanBaselineTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \return a table with the broadcast rows and two stations
+   */
+  static HeStationTable MakeTable (void);
+};
+
+HePlanBaselineTestCase::HePlanBaselineTestCase ()
+  : TestCase ("Lookahead plans are outdated by grown queues and SNR changes, not by MCS updates")
+{
+}
+
+HeStationTable
+HePlanBaselineTestCase::MakeTable (void)
+{
+  HeStationTable table;
+  for (uint8_t ac = 0; ac < AC_BE_NQOS; ac++)
+    {
+      table.Add (0, ac, 0);
+    }
+  for (uint16_t aid = 1; aid <= 2; aid++)
+    {
+      uint32_t row = table.Add (aid, AC_BE, 0);
+      table.bufferedBytes[row] = 10000;
+      table.ulBufferDepth[row] = 10000;
+      table.mcs[row] = 5;
+      table.lastSnr[row] = 100;
+    }
+  return table;
+}
+
+void
+HePlanBaselineTestCase::DoRun (void)
+{
+  const double hysteresis = 3;
+  HePlanBaseline baseline;
+
+  // IDEAL: the MCS column only moves when a snapshot is taken, the SNR of
+  // every received frame is what tells the link changed
+  HeStationTable table = MakeTable ();
+  baseline.Take (table);
+  NS_TEST_ASSERT_MSG_EQ (baseline.IsOutdated (table, hysteresis), false, "Fresh plan outdated");
+  table.lastSnr[AC_BE_NQOS] = 100 * std::pow (10, 0.1);
+  NS_TEST_ASSERT_MSG_EQ (baseline.IsOutdated (table, hysteresis), false, "Outdated by a 1 dB SNR change");
+  table.lastSnr[AC_BE_NQOS] = 100 / std::pow (10, 0.6);
+  NS_TEST_ASSERT_MSG_EQ (baseline.IsOutdated (table, hysteresis), true, "Not outdated by a 6 dB SNR drop");
+
+  // ARF: the MCS column moves on every success or failure count, on a
+  // stable link
+  table = MakeTable ();
+  baseline.Take (table);
+  table.mcs[AC_BE_NQOS] = 6;
+  table.mcs[AC_BE_NQOS + 1] = 4;
+  table.lastSnr[AC_BE_NQOS + 1] = 100 / std::pow (10, 0.05);
+  NS_TEST_ASSERT_MSG_EQ (baseline.IsOutdated (table, hysteresis), false, "Outdated by ARF MCS steps");
+  table.lastSnr[AC_BE_NQOS + 1] = 100 * std::pow (10, 0.5);
+  NS_TEST_ASSERT_MSG_EQ (baseline.IsOutdated (table, hysteresis), true, "Not outdated by a 5 dB SNR rise");
+
+  // Drained queues follow the plan, grown ones do not
+  table = MakeTable ();
+  baseline.Take (table);
+  table.bufferedBytes[AC_BE_NQOS] = 2000;
+  table.ulBufferDepth[AC_BE_NQOS + 1] = 0;
+  NS_TEST_ASSERT_MSG_EQ (baseline.IsOutdated (table, hysteresis), false, "Outdated by drained queues");
+  table.bufferedBytes[AC_BE_NQOS] = 12000;
+  NS_TEST_ASSERT_MSG_EQ (baseline.IsOutdated (table, hysteresis), true, "Not outdated by a grown DL queue");
+  table.bufferedBytes[AC_BE_NQOS] = 2000;
+  table.ulBufferDepth[AC_BE_NQOS + 1] = 12000;
+  NS_TEST_ASSERT_MSG_EQ (baseline.IsOutdated (table, hysteresis), true, "Not outdated by a grown UL report");
+
+  // A first SNR measurement of a station is a change
+  table = MakeTable ();
+  table.lastSnr[AC_BE_NQOS] = 0;
+  baseline.Take (table);
+  table.lastSnr[AC_BE_NQOS] = 100;
+  NS_TEST_ASSERT_MSG_EQ (baseline.IsOutdated (table, hysteresis), true, "Not outdated by a first SNR");
+}
+
+/**
+ * \brief HE scheduler plugin test suite
+ */
+class HeSchedulerTestSuite : public TestSuite
+{
+public:
+  HeSchedulerTestSuite ();
+};
+
+HeSchedulerTestSuite::HeSchedulerTestSuite ()
+  : TestSuite ("he-scheduler", UNIT)
+{
+  AddTestCase (new HePfSchedulerPlanTestCase, TestCase::QUICK);
+  AddTestCase (new HeBsrUlSchedulerPlanTestCase, TestCase::QUICK);
+  AddTestCase (new HeEdfSchedulerTestCase, TestCase::QUICK);
+  AddTestCase (new HePlanBaselineTestCase, TestCase::QUICK);
+}
+
+static HeSchedulerTestSuite g_heSchedulerTestSuite;
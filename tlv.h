@@ -140,4 +140,31 @@ int tlvDecodeAllStats(TlvBuffer* message,AllStats_t** clientArray,short* count);
 int tlvDecodeResults(TlvBuffer* message,RRMClientResponse_t** respArray,short* count);
 #endif
 
+/*
+ * Framed transport between ns-3 and the RRM server.
+ *
+ * A frame is a TLV_FRAME_HEADER_SIZE byte payload length in network order
+ * followed by the buf->len bytes of TLV data, instead of the whole
+ * sizeof(TlvBuffer) structure. The reader reassembles frames split over
+ * several reads and returns them one at a time when a read carries more
+ * than one. It also understands the legacy unframed stream of
+ * sizeof(TlvBuffer) records.
+ */
+#define TLV_FRAME_HEADER_SIZE 4
+#define TLV_FRAME_MAX_SIZE (TLV_FRAME_HEADER_SIZE + BUFFER_DATA_MAX_SIZE)
+
+typedef struct
+{
+    char data[2*sizeof(TlvBuffer)];
+    int start;   //Offset of the first byte not yet returned
+    int end;     //Offset one past the last received byte
+}TlvFrameReader;
+
+int tlvBuildFrame(TlvBuffer* buf,char* frame);
+int tlvWriteFrame(int fd,TlvBuffer* buf,bool framed);
+void tlvFrameReaderInit(TlvFrameReader* reader);
+int tlvFrameReaderPrepare(TlvFrameReader* reader);
+int tlvFrameReaderFill(TlvFrameReader* reader,int fd);
+int tlvFrameReaderNext(TlvFrameReader* reader,TlvBuffer* message,bool framed);
+
 #endif //TLV_H
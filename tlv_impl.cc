@@ -32,6 +32,10 @@
 #include<string.h>
 #include<stdlib.h>
 #include <arpa/inet.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/socket.h>
 #include "tlv.h"
 
 int tlvWriteTypeLen(TlvBuffer* buf,short type,short len){
@@ -294,3 +298,114 @@ void print_bytes(const void *object, size_t size)
 
 }
 
+/*
+ * Build the frame of buf into frame, which must hold TLV_FRAME_MAX_SIZE
+ * bytes. Returns the frame size.
+ */
+int tlvBuildFrame(TlvBuffer* buf,char* frame)
+{
+    unsigned int hdr = htonl(buf->len);
+    memcpy(frame,&hdr,TLV_FRAME_HEADER_SIZE);
+    memcpy(frame+TLV_FRAME_HEADER_SIZE,buf->data,buf->len);
+    return TLV_FRAME_HEADER_SIZE + buf->len;
+}
+
+/*
+ * Write one message. When framed, only the length header and the buf->len
+ * bytes of TLV data go on the wire, otherwise the whole TlvBuffer.
+ * Returns the number of bytes written or -1.
+ */
+int tlvWriteFrame(int fd,TlvBuffer* buf,bool framed)
+{
+    char frame[TLV_FRAME_MAX_SIZE];
+    const char* out = (const char*)buf;
+    int size = sizeof(TlvBuffer);
+    int sent = 0;
+    int ret;
+
+    if(framed){
+        size = tlvBuildFrame(buf,frame);
+        out = frame;
+    }
+    while(sent < size){
+        ret = write(fd,out+sent,size-sent);
+        if(ret < 0){
+            if(errno == EINTR)
+                continue;
+            return -1;
+        }
+        sent += ret;
+    }
+    return sent;
+}
+
+void tlvFrameReaderInit(TlvFrameReader* reader)
+{
+    reader->start = 0;
+    reader->end = 0;
+}
+
+/*
+ * Move the pending bytes to the front so that a whole frame always fits.
+ * Returns the room left after reader->end, where new bytes are appended.
+ */
+int tlvFrameReaderPrepare(TlvFrameReader* reader)
+{
+    if(reader->start > 0){
+        memmove(reader->data,reader->data+reader->start,reader->end-reader->start);
+        reader->end -= reader->start;
+        reader->start = 0;
+    }
+    return sizeof(reader->data)-reader->end;
+}
+
+/*
+ * Append whatever is available on fd to the reader.
+ * Returns the recv() result: bytes read, 0 on close, -1 on error.
+ */
+int tlvFrameReaderFill(TlvFrameReader* reader,int fd)
+{
+    int ret;
+
+    ret = recv(fd,reader->data+reader->end,tlvFrameReaderPrepare(reader),0);
+    if(ret > 0)
+        reader->end += ret;
+    return ret;
+}
+
+/*
+ * Extract the next complete message into message.
+ * Returns 1 if a message was extracted, 0 if more data is needed and -1 if
+ * the stream is corrupt.
+ */
+int tlvFrameReaderNext(TlvFrameReader* reader,TlvBuffer* message,bool framed)
+{
+    int pending = reader->end - reader->start;
+    unsigned int len;
+
+    if(!framed){
+        if(pending < (int)sizeof(TlvBuffer))
+            return 0;
+        memcpy(message,reader->data+reader->start,sizeof(TlvBuffer));
+        reader->start += sizeof(TlvBuffer);
+        return 1;
+    }
+
+    if(pending < TLV_FRAME_HEADER_SIZE)
+        return 0;
+    memcpy(&len,reader->data+reader->start,TLV_FRAME_HEADER_SIZE);
+    len = ntohl(len);
+    //Keep room for the zeroed type read past the last TLV by the parser
+    if(len > BUFFER_DATA_MAX_SIZE - TLV_TYPE_SIZE)
+        return -1;
+    if(pending < (int)(TLV_FRAME_HEADER_SIZE + len))
+        return 0;
+
+    memcpy(message->data,reader->data+reader->start+TLV_FRAME_HEADER_SIZE,len);
+    memset(message->data+len,0x00,TLV_TYPE_SIZE);
+    message->len = len;
+    message->write_offset = len;
+    message->read_offset = 0;
+    reader->start += TLV_FRAME_HEADER_SIZE + len;
+    return 1;
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+/*
+ * Stand-in RRM server for the shared memory transport.
+ *
+ * It creates the segment, then answers every TYPE_11AX_ACTIVATE_RRM with
+ * TYPE_11AX_RRM_RESULTS_RESP, granting one 26 tone RU of the first 20 MHz
+ * to each of the (up to) nine stations with the most buffered bytes in the
+ * requested direction, in their most loaded access category. It is meant to
+ * exercise RRMWifiManager with RrmTransport=SharedMemory without the real
+ * RRM server, not to schedule well.
+ *
+ * It is a program of its own, not part of the module library. Build it
+ * from this directory with the TLV and ring sources of the module:
+ *   g++ -std=c++11 -O2 -I.. -o rrm-stand-in-server rrm-stand-in-server.cc \
+ *       ../rrm-shm-ring.cc ../tlv_impl.cc -lrt
+ * and start it before the simulation:
+ *   ./rrm-stand-in-server [-n /ns3-rrm] [-a]
+ * -a tells the server that the simulation runs with RrmAsync=true and
+ * pushes its station report after each request instead of being asked.
+ * Without it, the server asks anyway and the simulation does not answer
+ * the request of a round whose report it already pushed.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sched.h>
+#include <algorithm>
+#include "tlv.h"
+#include "rrm-shm-ring.h"
+
+//tlv.h keeps the declarations of tlv_impl.cc under #if 0
+int tlvEncode1Byte(TlvBuffer* buf,short type,char val);
+int tlvEncodeResults(TlvBuffer* buf,short type,RRMClientResponse_t* respArray,short count);
+int tlvReadType(TlvBuffer* message,short* type);
+int tlvDecode1Byte(TlvBuffer* message,char* val);
+int tlvDecodeAllStats(TlvBuffer* message,AllStats_t** clientArray,short* count);
+
+#define STAND_IN_MAX_STATIONS 9    //26 tone RUs in 20 MHz
+#define STAND_IN_AC_BE 0           //Same numbering as ns3::AcIndex
+#define STAND_IN_AC_VI 2
+#define STAND_IN_AC_VO 3
+
+static volatile sig_atomic_t g_running = 1;
+
+static void standInStop(int sig)
+{
+    g_running = 0;
+}
+
+static void standInSend(RrmShmSegment* segment,TlvBuffer* message)
+{
+    while(rrmShmWriteFrame(&segment->toClient,message) == 0 && g_running){
+        sched_yield();
+    }
+}
+
+static int standInLoad(AllStats_t* stats,int ac,bool isDownlink)
+{
+    return isDownlink ? stats->bufferDepthDL[ac] : stats->bufferDepthUL[ac];
+}
+
+/*
+ * Build the results of one round from the station report.
+ */
+static void standInSchedule(RrmShmSegment* segment,AllStats_t* clientArray,short count,bool isDownlink)
+{
+    static const int acs[] = {STAND_IN_AC_VO,STAND_IN_AC_VI,STAND_IN_AC_BE};
+    RRMClientResponse_t respArray[STAND_IN_MAX_STATIONS];
+    int load[STAND_IN_MAX_STATIONS];
+    TlvBuffer message;
+    short nResp = 0;
+    short i;
+    short j;
+    short k;
+
+    for(i = 0;i<count;i++){
+        int bestAc = -1;
+        int bestLoad = 0;
+        for(j = 0;j<3;j++){
+            int l = standInLoad(&clientArray[i],acs[j],isDownlink);
+            if(l > bestLoad){
+                bestLoad = l;
+                bestAc = acs[j];
+            }
+        }
+        if(bestAc < 0)
+            continue;
+        //Keep the most loaded stations, sorted by decreasing load
+        for(k = nResp;k > 0 && load[k-1] < bestLoad;k--){
+            if(k < STAND_IN_MAX_STATIONS){
+                respArray[k] = respArray[k-1];
+                load[k] = load[k-1];
+            }
+        }
+        if(k >= STAND_IN_MAX_STATIONS)
+            continue;
+        memcpy(respArray[k].macStr,clientArray[i].macStr,MAC_ADDR_LEN);
+        respArray[k].trafficType = bestAc;
+        respArray[k].mcsValue = clientArray[i].mcsVal;
+        respArray[k].chanW = 2;
+        load[k] = bestLoad;
+        nResp = std::min(nResp+1,STAND_IN_MAX_STATIONS);
+    }
+    for(i = 0;i<nResp;i++){
+        respArray[i].ruBitMap = 2*i;
+    }
+
+    memset(&message,0x00,sizeof(message));
+    tlvEncodeResults(&message,TYPE_11AX_RRM_RESULTS_RESP,respArray,nResp);
+    standInSend(segment,&message);
+}
+
+int main(int argc,char** argv)
+{
+    const char* name = RRM_SHM_DEFAULT_NAME;
+    bool pushedStats = false;
+    bool isDownlink = true;
+    bool roundPending = false;
+    RrmShmSegment* segment;
+    TlvFrameReader reader;
+    TlvBuffer message;
+    int opt;
+
+    while((opt = getopt(argc,argv,"n:a")) != -1){
+        switch(opt){
+            case 'n':
+                name = optarg;
+                break;
+            case 'a':
+                pushedStats = true;
+                break;
+            default:
+                fprintf(stderr,"usage: %s [-n shm name] [-a]\n",argv[0]);
+                return 1;
+        }
+    }
+
+    segment = rrmShmCreate(name);
+    if(segment == NULL){
+        perror("rrmShmCreate");
+        return 1;
+    }
+    signal(SIGINT,standInStop);
+    signal(SIGTERM,standInStop);
+    tlvFrameReaderInit(&reader);
+    printf("RRM stand-in server listening on %s\n",name);
+
+    while(g_running){
+        if(rrmShmFrameReaderFill(&reader,&segment->toServer) == 0){
+            sched_yield();
+            continue;
+        }
+        while(tlvFrameReaderNext(&reader,&message,true) == 1){
+            short type;
+            char val;
+            AllStats_t* clientArray = NULL;
+            short count = 0;
+
+            tlvReadType(&message,&type);
+            switch(type){
+                case TYPE_11AX_ACTIVATE_RRM:
+                    tlvDecode1Byte(&message,&val);
+                    isDownlink = val;
+                    roundPending = true;
+                    if(!pushedStats){
+                        memset(&message,0x00,sizeof(message));
+                        tlvEncode1Byte(&message,TYPE_11AX_ALL_STATS_REQ,false);
+                        standInSend(segment,&message);
+                    }
+                    break;
+                case TYPE_11AX_ALL_STATS_RESP:
+                    tlvDecodeAllStats(&message,&clientArray,&count);
+                    if(roundPending){
+                        standInSchedule(segment,clientArray,count,isDownlink);
+                        roundPending = false;
+                    }
+                    free(clientArray);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    rrmShmDestroy(segment,name);
+    return 0;
+}
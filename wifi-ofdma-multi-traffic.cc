@@ -32,6 +32,8 @@
 #include "ns3/wifi-module.h"
 #include "ns3/internet-module.h"
 #include "ns3/gnuplot.h"
+#include "ns3/he-delay-histogram.h"
+#include "ns3/he-traffic-source.h"
 
 #include <iostream>
 #include <fstream>
@@ -44,14 +46,10 @@ using namespace ns3;
 NS_LOG_COMPONENT_DEFINE ("WifiSimpleInfra");
 
 Ptr<UniformRandomVariable> mobilityRandom = CreateObject<UniformRandomVariable> ();
-Ptr<UniformRandomVariable> pktSizeRandom = CreateObject<UniformRandomVariable> ();
-Ptr<UniformRandomVariable> pktSilenceBusyIntervalVoip = CreateObject<UniformRandomVariable> ();
 Ptr<UniformRandomVariable> initStaTimeRandom = CreateObject<UniformRandomVariable> ();
 Ptr<UniformRandomVariable> globalRv = CreateObject<UniformRandomVariable> ();
 Ptr<UniformRandomVariable> locationRv = CreateObject<UniformRandomVariable> ();
 
-#define  VOIP_BUSY_INTERVAL_20MS_START  8
-#define  VOIP_BUSY_INTERVAL_20MS_END    12 
 #define  _ENABLE_DEBUG_   0 
 
 enum clientPosition_t {
@@ -79,13 +77,13 @@ uint32_t  nVoipStas = 0;
 uint32_t  nVideoStas = 0;
 uint32_t  nDataStas = 0;
 bool  downlink = false;
+bool  rawStats = false;
+bool  saturated = false;
+bool  videoBurst = false;
 
 std::vector<Ptr<Socket>> recvSockPtr;
-std::vector<Ptr<Socket>> sendSockPtr;
 std::vector<Ptr<Socket>> dataRecvSockPtr;
-std::vector<Ptr<Socket>> dataSendSockPtr;
 std::vector<Ptr<Socket>> videoRecvSockPtr;
-std::vector<Ptr<Socket>> videoSendSockPtr;
 
 
 typedef struct pktStats_ {
@@ -103,9 +101,7 @@ typedef struct pktStats_ {
    uint32_t typeOfClientTraffic;
    uint32_t lastLatency;
    uint32_t currentPktCount;
-   uint32_t maxPktCount;
    uint32_t lastRecvPktNumber;
-   uint32_t intervalRandom;
    uint32_t startTime;
    double   aggDistance;
    double   avgPktSize;
@@ -114,65 +110,17 @@ typedef struct pktStats_ {
    double   dropAfterQueue;
    double   dropTotal;
    std::vector<double > coordinates;
-   std::vector<uint64_t> latencyStats;
+   HeDelayHistogram latencyHist;
+   HeDelayHistogram jitterHist;
+   std::vector<uint64_t> latencyStats;   // Raw samples, only kept with rawStats
    std::vector<uint64_t> jitterStats;
-   std::vector<double > perStats;
+   Ptr<HeTrafficSource> source;
 } pktStats_t;
 
 std::vector<pktStats_t> pktStats;
 std::vector<pktStats_t> dataPktStats;
 std::vector<pktStats_t> videoPktStats;
 
-void bufferToData64(uint64_t *data, unsigned char *recvBuffer, uint32_t start) 
-{
-  *data = recvBuffer[start + 7];
-  *data <<= 8;
-  *data |= recvBuffer[start + 6];
-  *data <<= 8;
-  *data |= recvBuffer[start + 5];
-  *data <<= 8;
-  *data |= recvBuffer[start + 4];
-  *data <<= 8;
-  *data |= recvBuffer[start + 3];
-  *data <<= 8;
-  *data |= recvBuffer[start + 2];
-  *data <<= 8;
-  *data |= recvBuffer[start + 1];
-  *data <<= 8;
-  *data |= recvBuffer[start];
-}
-
-void bufferToData32(uint32_t *data, unsigned char *recvBuffer, uint32_t start) 
-{
-  *data |= recvBuffer[start + 3];
-  *data <<= 8;
-  *data |= recvBuffer[start + 2];
-  *data <<= 8;
-  *data |= recvBuffer[start + 1];
-  *data <<= 8;
-  *data |= recvBuffer[start];
-}
-
-void dataToBuffer64(unsigned char *buffer, uint64_t data, uint32_t start)
-{
-  buffer[start] = (data >> 0) & 0xff;
-  buffer[start + 1] = (data >> 8) & 0xff;
-  buffer[start + 2] = (data >> 16) & 0xff;
-  buffer[start + 3] = (data >> 24) & 0xff;
-  buffer[start + 4] = (data >> 32) & 0xff;
-  buffer[start + 5] = (data >> 40) & 0xff;
-  buffer[start + 6] = (data >> 48) & 0xff;
-  buffer[start + 7] = (data >> 56) & 0xff;
-}
-
-void dataToBuffer32(unsigned char *buffer, uint32_t data, uint32_t start)
-{
-  buffer[start] = (data >> 0) & 0xff;
-  buffer[start + 1] = (data >> 8) & 0xff;
-  buffer[start + 2] = (data >> 16) & 0xff;
-  buffer[start + 3] = (data >> 24) & 0xff;
-}
-
 enum clientTraffic {
    CLIENT_TRAFFIC_TYPE_VOICE = 1,
    CLIENT_TRAFFIC_TYPE_VIDEO,
@@ -194,241 +142,119 @@ std::string ClientTrafficTypeToStr(uint32_t trafficType)
    return "Unknown";
 }
 
-void DataReceivePacket (Ptr<Socket> socket)
+/*
+ * Receive callback of every flow. The stats of the flow are bound to the
+ * callback when its socket is set up, so that a packet is accounted for
+ * without looking its socket up among the sockets of the other flows.
+ */
+void ReceiveFlowPacket (std::vector<pktStats_t> *flowStats, uint32_t rit, Ptr<Socket> socket)
 {
+  pktStats_t &flow = (*flowStats)[rit];
   Ptr<Packet> m_receivedPacket;
-  uint32_t recvBytes;
   uint64_t startTime, latency, jitter = 0;
   double per = 0.0;
-  unsigned char recvBuffer[1500];
   Time time_now;
   uint32_t recvPktNumber = 0;
 
   while ((m_receivedPacket = socket->Recv ()))
     {
-        for (std::vector<Ptr<Socket>>::size_type rit = 0; rit < dataRecvSockPtr.size(); rit++) {
-            if(socket == dataRecvSockPtr[rit]) {
-                memset(recvBuffer, '\0', sizeof(recvBuffer));
-                recvBytes = m_receivedPacket->CopyData(recvBuffer, 16);
- 
-                NS_ASSERT(recvBytes);
-                bufferToData64(&startTime, recvBuffer, 0);  //Decode from 0th byte
-                bufferToData32(&recvPktNumber, recvBuffer, 8);  //Decode from 8th byte
-
-                time_now = Now(); 
-                latency = time_now.GetNanoSeconds() - startTime;
-                dataPktStats[rit].latencyStats.push_back(latency);
+        HeTrafficHeader header;
+        m_receivedPacket->RemoveHeader (header);
+        startTime = header.GetTimestamp ().GetNanoSeconds ();
+        recvPktNumber = header.GetSequence ();
+        flow.source->NotifyDequeue (recvPktNumber);
+
+        time_now = Now(); 
+        latency = time_now.GetNanoSeconds() - startTime;
+        flow.latencyHist.Add(latency);
+        if(rawStats) {
+            flow.latencyStats.push_back(latency);
+        }
+
+        PerTag tag;
+        m_receivedPacket->RemovePacketTag (tag);
+        per = tag.Get(); //m_receivedPacket->m_per;
+        if((!flow.avgPer) && (per)) {
+            flow.avgPer = per;
+            flow.numPer = 1;
+        } else {
+            flow.avgPer = ( (flow.avgPer * (flow.numPer)) + per) / (flow.numPer + 1);
+            flow.numPer ++;
+        }
            
-                PerTag tag;
-                m_receivedPacket->RemovePacketTag (tag);
-                per = tag.Get(); //m_receivedPacket->m_per;
-                dataPktStats[rit].perStats.push_back(per);
-                if((!dataPktStats[rit].avgPer) && (per)) {
-                    dataPktStats[rit].avgPer = per;
-                    dataPktStats[rit].numPer = 1;
-                } else {
-                    dataPktStats[rit].avgPer = ( (dataPktStats[rit].avgPer * (dataPktStats[rit].numPer)) + per) / (dataPktStats[rit].numPer + 1);
-                    dataPktStats[rit].numPer ++;
+        #if _ENABLE_DEBUG_ 
+        NS_LOG_UNCOND("### Packet Number Received : " << recvPktNumber << "  now @ : " << Now() << " Latency (millisecond) : " << latency / 1000000.0); 
+        #endif
+
+        flow.pktRecv ++;
+        if(flow.pktRecv > pktMonitor) {
+
+            if(!flow.lastLatency) {
+                flow.lastLatency = latency;
+                flow.worstJitter = 0; 
+                flow.lastRecvPktNumber = recvPktNumber;
+            } else {
+                jitter = (flow.lastLatency > latency) ? (flow.lastLatency - latency) : (latency - flow.lastLatency);
+                flow.jitterHist.Add(jitter);
+                if(rawStats) {
+                    flow.jitterStats.push_back(jitter);
                 }
-
+                
                 #if _ENABLE_DEBUG_ 
-                NS_LOG_UNCOND("### Packet Number Received : " << recvPktNumber << "  now @ : " << Now() << " Latency (millisecond) : " << latency / 1000000.0); 
+                NS_LOG_UNCOND("#### Jitter with respect to present packet number : " << recvPktNumber << " and previous packet number : " << \
+                    flow.lastRecvPktNumber << " in (milli seconds) : " << jitter / 1000000.0); 
                 #endif
-
-                dataPktStats[rit].pktRecv ++;
-                if(dataPktStats[rit].pktRecv > pktMonitor) {
-
-                    if(!dataPktStats[rit].lastLatency) {
-                        dataPktStats[rit].lastLatency = latency;
-                        dataPktStats[rit].worstJitter = 0; 
-                        dataPktStats[rit].lastRecvPktNumber = recvPktNumber;
-                    } else {
-                        jitter = (dataPktStats[rit].lastLatency > latency) ? (dataPktStats[rit].lastLatency - latency) : (latency - dataPktStats[rit].lastLatency);
-                        dataPktStats[rit].jitterStats.push_back(jitter);
-                        
-                        #if _ENABLE_DEBUG_ 
-                        NS_LOG_UNCOND("#### Jitter with respect to present packet number : " << recvPktNumber << " and previous packet number : " << \
-                            dataPktStats[rit].lastRecvPktNumber << " in (milli seconds) : " << jitter / 1000000.0); 
-                        #endif
-                        dataPktStats[rit].lastRecvPktNumber = recvPktNumber;
-                        dataPktStats[rit].lastLatency = latency; 
-                        if(dataPktStats[rit].worstJitter < jitter) {
-                            dataPktStats[rit].worstJitter = jitter;
-                        }
-                    }
-                    if((!dataPktStats[rit].avgJitter) && (jitter)) {
-                        dataPktStats[rit].avgJitter = jitter;               
-                        dataPktStats[rit].numJitter = 1; 
-                    } else { 
-                        dataPktStats[rit].avgJitter = ( (dataPktStats[rit].avgJitter * (dataPktStats[rit].numJitter)) + jitter) / (dataPktStats[rit].numJitter + 1); 
-                        dataPktStats[rit].numJitter ++; 
-                    }
-
-
-                    if(dataPktStats[rit].worstLatency < latency) {
-                        dataPktStats[rit].worstLatency = latency;
-                    }
-                    if(!dataPktStats[rit].avgLatency) {
-                        dataPktStats[rit].avgLatency = latency;                
-                    } else { 
-                        dataPktStats[rit].avgLatency = ( (dataPktStats[rit].avgLatency * (dataPktStats[rit].pktRecv - 1 - pktMonitor)) + latency) / (dataPktStats[rit].pktRecv - pktMonitor);
-                    }
-                    if( (!dataPktStats[rit].bestLatency) || (dataPktStats[rit].bestLatency > latency) ) {
-                        dataPktStats[rit].bestLatency = latency;
-                    }
+                flow.lastRecvPktNumber = recvPktNumber;
+                flow.lastLatency = latency; 
+                if(flow.worstJitter < jitter) {
+                    flow.worstJitter = jitter;
                 }
             }
-        }
-    }
-}
-
-void ReceivePacket (Ptr<Socket> socket)
-{
-  Ptr<Packet> m_receivedPacket;
-  uint32_t recvBytes;
-  uint64_t startTime, latency, jitter = 0;
-  double per = 0.0;
-  unsigned char recvBuffer[1500];
-  Time time_now;
-  uint32_t recvPktNumber = 0;
+            if((!flow.avgJitter) && (jitter)) {
+                flow.avgJitter = jitter;               
+                flow.numJitter = 1; 
+            } else { 
+                flow.avgJitter = ( (flow.avgJitter * (flow.numJitter)) + jitter) / (flow.numJitter + 1); 
+                flow.numJitter ++; 
+            }
 
-  while ((m_receivedPacket = socket->Recv ()))
-    {
-        for (std::vector<Ptr<Socket>>::size_type rit = 0; rit < recvSockPtr.size(); rit++) {
-            if(socket == recvSockPtr[rit]) {
-                memset(recvBuffer, '\0', sizeof(recvBuffer));
-                recvBytes = m_receivedPacket->CopyData(recvBuffer, 16);
- 
-                NS_ASSERT(recvBytes);
-                bufferToData64(&startTime, recvBuffer, 0);  //Decode from 0th byte
-                bufferToData32(&recvPktNumber, recvBuffer, 8);  //Decode from 8th byte
-
-                time_now = Now(); 
-                latency = time_now.GetNanoSeconds() - startTime;
-                pktStats[rit].latencyStats.push_back(latency);
-
-                PerTag tag;
-                m_receivedPacket->RemovePacketTag (tag);
-                per = tag.Get(); //m_receivedPacket->m_per;
-                pktStats[rit].perStats.push_back(per);
-                if((!pktStats[rit].avgPer) && (per)) {
-                    pktStats[rit].avgPer = per;
-                    pktStats[rit].numPer = 1;
-                } else {
-                    pktStats[rit].avgPer = ( (pktStats[rit].avgPer * (pktStats[rit].numPer)) + per) / (pktStats[rit].numPer + 1);
-                    pktStats[rit].numPer ++;
-                }
-           
-                #if _ENABLE_DEBUG_ 
-                NS_LOG_UNCOND("### Packet Number Received : " << recvPktNumber << "  now @ : " << Now() << " Latency (millisecond) : " << latency / 1000000.0); 
-                #endif
 
-                pktStats[rit].pktRecv ++;
-                if(pktStats[rit].pktRecv > pktMonitor) {
-
-                    if(!pktStats[rit].lastLatency) {
-                        pktStats[rit].lastLatency = latency;
-                        pktStats[rit].worstJitter = 0; 
-                        pktStats[rit].lastRecvPktNumber = recvPktNumber;
-                    } else {
-                        jitter = (pktStats[rit].lastLatency > latency) ? (pktStats[rit].lastLatency - latency) : (latency - pktStats[rit].lastLatency);
-                        pktStats[rit].jitterStats.push_back(jitter);
-                        
-                        #if _ENABLE_DEBUG_ 
-                        NS_LOG_UNCOND("#### Jitter with respect to present packet number : " << recvPktNumber << " and previous packet number : " << \
-                            pktStats[rit].lastRecvPktNumber << " in (milli seconds) : " << jitter / 1000000.0); 
-                        #endif
-                        pktStats[rit].lastRecvPktNumber = recvPktNumber;
-                        pktStats[rit].lastLatency = latency; 
-                        if(pktStats[rit].worstJitter < jitter) {
-                            pktStats[rit].worstJitter = jitter;
-                        }
-                    }
-                    if((!pktStats[rit].avgJitter) && (jitter)) {
-                        pktStats[rit].avgJitter = jitter;               
-                        pktStats[rit].numJitter = 1; 
-                    } else { 
-                        pktStats[rit].avgJitter = ( (pktStats[rit].avgJitter * (pktStats[rit].numJitter)) + jitter) / (pktStats[rit].numJitter + 1); 
-                        pktStats[rit].numJitter ++; 
-                    }
-
-
-                    if(pktStats[rit].worstLatency < latency) {
-                        pktStats[rit].worstLatency = latency;
-                    }
-                    if(!pktStats[rit].avgLatency) {
-                        pktStats[rit].avgLatency = latency;                
-                    } else { 
-                        pktStats[rit].avgLatency = ( (pktStats[rit].avgLatency * (pktStats[rit].pktRecv - 1 - pktMonitor)) + latency) / (pktStats[rit].pktRecv - pktMonitor);
-                    }
-                    if( (!pktStats[rit].bestLatency) || (pktStats[rit].bestLatency > latency) ) {
-                        pktStats[rit].bestLatency = latency;
-                    }
-                }
+            if(flow.worstLatency < latency) {
+                flow.worstLatency = latency;
+            }
+            if(!flow.avgLatency) {
+                flow.avgLatency = latency;                
+            } else { 
+                flow.avgLatency = ( (flow.avgLatency * (flow.pktRecv - 1 - pktMonitor)) + latency) / (flow.pktRecv - pktMonitor);
+            }
+            if( (!flow.bestLatency) || (flow.bestLatency > latency) ) {
+                flow.bestLatency = latency;
             }
         }
     }
 }
 
-static void GenerateVoiceTraffic (uint32_t pktSize, Time pktInterval, uint32_t staIndex)
+/*
+ * Tx trace of the traffic source of every flow, bound to the stats of the
+ * flow as the receive callback.
+ */
+void FlowPacketSent (std::vector<pktStats_t> *flowStats, uint32_t rit, Ptr<const Packet> packet)
 {
-  uint32_t randPacketSize;
-  Time duration_time;
-  uint64_t duration_now;
-
-  std::vector<Ptr<Socket>>::size_type rit = staIndex;
-  
-  if(rit < recvSockPtr.size()) { 
-      if(pktStats[rit].currentPktCount < pktStats[rit].maxPktCount) {
-           sendSockPtr[rit]->SetIpTos (192);  // AF11
-           pktStats[rit].typeOfClientTraffic = CLIENT_TRAFFIC_TYPE_VOICE;
-
-           //  sendSockPtr[rit]->SetPriority (6);  // Interactive
-           //randPacketSize = pktSizeRandom->GetValue(200, 1000);
-           randPacketSize = pktSizeRandom->GetValue(pktSize, pktSize);
-
-           duration_time = Now();
-           duration_now = (double)duration_time.GetNanoSeconds ();
-
-           pktStats[rit].currentPktCount ++;
-           uint8_t buffer[randPacketSize];
-           dataToBuffer64(buffer, duration_now, 0);    // Encode from 0th byte
-           dataToBuffer32(buffer, pktStats[rit].currentPktCount, 8); // Encode from 8th byte
-
-           sendSockPtr[rit]->Send (buffer, randPacketSize, 0);
-
-           pktStats[rit].pktSent ++;
-           #if _ENABLE_DEBUG_ 
-           NS_LOG_UNCOND("\n ");
-           NS_LOG_UNCOND("### Enqueuing the packet now : " << Now() << " Packet Count : " << pktStats[rit].currentPktCount);
-           #endif
-      } else {
-           sendSockPtr[rit]->Close();
-      }
-  }
-
-  if(pktStats[rit].intervalRandom) {
-     if (pktStats[rit].pktSent == 1){
-       Simulator::Schedule (MilliSeconds(20.0)+ Seconds(1.0), &GenerateVoiceTraffic, 
-                        pktSize, MilliSeconds(20.0), staIndex);
-     }
-     else{
-       Simulator::Schedule (MilliSeconds(20.0), &GenerateVoiceTraffic, 
-                        pktSize, MilliSeconds(20.0), staIndex);
-     }
-       pktStats[rit].intervalRandom --;
+  pktStats_t &flow = (*flowStats)[rit];
+  uint32_t pktSize = packet->GetSize ();
+
+  flow.pktSent ++;
+  flow.currentPktCount ++;
+  if((!flow.avgPktSize) && (pktSize)) {
+    flow.avgPktSize = pktSize;
+    flow.numPkt = 1;
   } else {
-       pktStats[rit].intervalRandom = pktSilenceBusyIntervalVoip->GetValue(VOIP_BUSY_INTERVAL_20MS_START, VOIP_BUSY_INTERVAL_20MS_END);
-     if (pktStats[rit].pktSent == 1){
-       Simulator::Schedule (MilliSeconds(160.0)+ Seconds(1.0), &GenerateVoiceTraffic, 
-                           pktSize, MilliSeconds(160.0), staIndex);
-     }
-     else {
-       Simulator::Schedule (MilliSeconds(160.0), &GenerateVoiceTraffic, 
-                           pktSize, MilliSeconds(160.0), staIndex);
-     }
-  } 
-
+    flow.avgPktSize = ( (flow.avgPktSize * (flow.numPkt)) + pktSize) / (flow.numPkt + 1);
+    flow.numPkt ++;
+  }
+  #if _ENABLE_DEBUG_ 
+  NS_LOG_UNCOND("### Enqueuing the packet now : " << Now() << " Packet Count : " << flow.currentPktCount);
+  #endif
 }
 
 const std::string currentDateTime() 
@@ -450,271 +276,6 @@ static void PrintRunningTime()
    Simulator::Schedule (Seconds(1.0), &PrintRunningTime);
 }
 
-static void GenerateDataTraffic (uint32_t pktSize, Time pktInterval, uint32_t staIndex)
-{
-  uint32_t randPacketSize;
-  Time duration_time;
-  uint64_t duration_now;
-
-  std::vector<Ptr<Socket>>::size_type rit = staIndex;
-  
-  if(rit < dataRecvSockPtr.size()) { 
-      if(dataPktStats[rit].currentPktCount < dataPktStats[rit].maxPktCount) {
-           dataSendSockPtr[rit]->SetIpTos (0);  // AF11
-           dataPktStats[rit].typeOfClientTraffic = CLIENT_TRAFFIC_TYPE_BESTEFFORT;
-
-           randPacketSize = pktSizeRandom->GetValue(pktSize, pktSize);
-
-           duration_time = Now();
-           duration_now = (double)duration_time.GetNanoSeconds ();
-
-           dataPktStats[rit].currentPktCount ++;
-           uint8_t buffer[randPacketSize];
-           dataToBuffer64(buffer, duration_now, 0);    // Encode from 0th byte
-           dataToBuffer32(buffer, dataPktStats[rit].currentPktCount, 8); // Encode from 8th byte
-
-           dataSendSockPtr[rit]->Send (buffer, randPacketSize, 0);
-
-           dataPktStats[rit].pktSent ++;
-           #if _ENABLE_DEBUG_ 
-           NS_LOG_UNCOND("\n ");
-           NS_LOG_UNCOND("### Enqueuing the packet now : " << Now() << " Packet Count : " << dataPktStats[rit].currentPktCount);
-           #endif
-      } else {
-           dataSendSockPtr[rit]->Close();
-      }
-  }
-
-    if (dataPktStats[rit].pktSent == 1){
-       Simulator::Schedule (pktInterval+Seconds(1.0), &GenerateDataTraffic, 
-                        pktSize, pktInterval, staIndex);
-    }
-    else {
-       Simulator::Schedule (pktInterval, &GenerateDataTraffic, 
-                        pktSize, pktInterval, staIndex);
-    }
-}
-
-void VideoReceivePacket (Ptr<Socket> socket)
-{
-  Ptr<Packet> m_receivedPacket;
-  uint32_t recvBytes;
-  uint64_t startTime, latency, jitter = 0;
-  double per = 0.0;
-  unsigned char recvBuffer[1500];
-  Time time_now;
-  uint32_t recvPktNumber = 0;
-
-  while ((m_receivedPacket = socket->Recv ()))
-    {
-        for (std::vector<Ptr<Socket>>::size_type rit = 0; rit < videoRecvSockPtr.size(); rit++) {
-            if(socket == videoRecvSockPtr[rit]) {
-//                NS_LOG_UNCOND("Video packet received for video sta : " << videoPktStats[rit].coordinates[0]);
-                memset(recvBuffer, '\0', sizeof(recvBuffer));
-                recvBytes = m_receivedPacket->CopyData(recvBuffer, 16);
- 
-                NS_ASSERT(recvBytes);
-                bufferToData64(&startTime, recvBuffer, 0);  //Decode from 0th byte
-                bufferToData32(&recvPktNumber, recvBuffer, 8);  //Decode from 8th byte
-
-                time_now = Now(); 
-                latency = time_now.GetNanoSeconds() - startTime;
-                videoPktStats[rit].latencyStats.push_back(latency);
-           
-                PerTag tag;
-                m_receivedPacket->RemovePacketTag (tag);
-                per = tag.Get(); //m_receivedPacket->m_per;
-                videoPktStats[rit].perStats.push_back(per);
-                if((!videoPktStats[rit].avgPer) && (per)) {
-                    videoPktStats[rit].avgPer = per;
-                    videoPktStats[rit].numPer = 1;
-                } else {
-                    videoPktStats[rit].avgPer = ( (videoPktStats[rit].avgPer * (videoPktStats[rit].numPer)) + per) / (videoPktStats[rit].numPer + 1);
-                    videoPktStats[rit].numPer ++;
-                }
-
-                #if _ENABLE_DEBUG_ 
-                NS_LOG_UNCOND("### Packet Number Received : " << recvPktNumber << "  now @ : " << Now() << " Latency (millisecond) : " << latency / 1000000.0); 
-                #endif
-
-                videoPktStats[rit].pktRecv ++;
-                if(videoPktStats[rit].pktRecv > pktMonitor) {
-
-                    if(!videoPktStats[rit].lastLatency) {
-                        videoPktStats[rit].lastLatency = latency;
-                        videoPktStats[rit].worstJitter = 0; 
-                        videoPktStats[rit].lastRecvPktNumber = recvPktNumber;
-                    } else {
-                        jitter = (videoPktStats[rit].lastLatency > latency) ? (videoPktStats[rit].lastLatency - latency) : (latency - videoPktStats[rit].lastLatency);
-                        videoPktStats[rit].jitterStats.push_back(jitter);
-                        
-                        #if _ENABLE_DEBUG_ 
-                        NS_LOG_UNCOND("#### Jitter with respect to present packet number : " << recvPktNumber << " and previous packet number : " << \
-                            videoPktStats[rit].lastRecvPktNumber << " in (milli seconds) : " << jitter / 1000000.0); 
-                        #endif
-                        videoPktStats[rit].lastRecvPktNumber = recvPktNumber;
-                        videoPktStats[rit].lastLatency = latency; 
-                        if(videoPktStats[rit].worstJitter < jitter) {
-                            videoPktStats[rit].worstJitter = jitter;
-                        }
-                    }
-                    if((!videoPktStats[rit].avgJitter) && (jitter)) {
-                        videoPktStats[rit].avgJitter = jitter;               
-                        videoPktStats[rit].numJitter = 1; 
-                    } else { 
-                        videoPktStats[rit].avgJitter = ( (videoPktStats[rit].avgJitter * (videoPktStats[rit].numJitter)) + jitter) / (videoPktStats[rit].numJitter + 1); 
-                        videoPktStats[rit].numJitter ++; 
-                    }
-
-
-                    if(videoPktStats[rit].worstLatency < latency) {
-                        videoPktStats[rit].worstLatency = latency;
-                    }
-                    if(!videoPktStats[rit].avgLatency) {
-                        videoPktStats[rit].avgLatency = latency;                
-                    } else { 
-                        videoPktStats[rit].avgLatency = ( (videoPktStats[rit].avgLatency * (videoPktStats[rit].pktRecv - 1 - pktMonitor)) + latency) / (videoPktStats[rit].pktRecv - pktMonitor);
-                    }
-                    if( (!videoPktStats[rit].bestLatency) || (videoPktStats[rit].bestLatency > latency) ) {
-                        videoPktStats[rit].bestLatency = latency;
-                    }
-                }
-            }
-        }
-    }
-}
-
-void GetWeibullParameterFromVideoClass(double *scale, double *shape, uint8_t videoClass)
-{
-  if (videoClass == 1)
-  {
-    *scale = 6950;
-    *shape = 0.8099;
-  }
-  else if (videoClass == 2)
-  {
-    *scale = 13900;
-    *shape = 0.8099;
-  }
-  else if (videoClass == 3)
-  {
-    *scale = 20850;
-    *shape = 0.8099;
-  }
-  else if (videoClass == 4)
-  {
-    *scale = 27800;
-    *shape = 0.8099;
-  }
-  else if (videoClass == 5)
-  {
-    *scale = 34750;
-    *shape = 0.8099;
-  }
-  else if (videoClass == 6)
-  {
-    *scale = 54210;
-    *shape = 0.8099;
-  }
-  return;
-}
-
-void GenerateVideoFrameTraffic (int32_t frameSize, uint32_t staIndex)
-{
-  std::vector<Ptr<Socket>>::size_type rit = staIndex;
-  uint8_t buffer[frameSize];
-  Time duration_time;
-  uint64_t duration_now;
-
-  videoPktStats[rit].pktSent ++;
-  //NS_LOG_UNCOND("Sending frame for STA : " << staIndex << " Size : " << frameSize << " Now : " << Now());
-  if((!videoPktStats[rit].avgPktSize) && (frameSize)) {
-    videoPktStats[rit].avgPktSize = frameSize;
-    videoPktStats[rit].numPkt = 1;
-  } else {
-    videoPktStats[rit].avgPktSize = ( (videoPktStats[rit].avgPktSize * (videoPktStats[rit].numPkt)) + frameSize) / (videoPktStats[rit].numPkt + 1);
-    videoPktStats[rit].numPkt ++;
-  }
-  videoSendSockPtr[rit]->SetIpTos (136);  // AF41
-  videoPktStats[rit].typeOfClientTraffic = CLIENT_TRAFFIC_TYPE_VIDEO;
-  videoPktStats[rit].currentPktCount ++;
-  duration_time = Now();
-  duration_now = (double)duration_time.GetNanoSeconds ();
-  dataToBuffer64(buffer, duration_now, 0);    // Encode from 0th byte
-  dataToBuffer32(buffer, videoPktStats[rit].currentPktCount, 8); // Encode from 8th byte
-  videoSendSockPtr[rit]->Send (buffer, frameSize, 0);
-}
-
-static void GenerateVideoTraffic (Time pktInterval, uint32_t staIndex, uint8_t videoClass)
-{
-/*************Packet Size**************/
-  int32_t pktSize = 0;
-  double scale = 0.0;          //lambda
-  double shape = 0.0;          // k
-  GetWeibullParameterFromVideoClass(&scale, &shape, videoClass);
-  Ptr<WeibullRandomVariable> wRv = CreateObject<WeibullRandomVariable> ();
-  wRv->SetAttribute ("Scale", DoubleValue (scale));
-  wRv->SetAttribute ("Shape", DoubleValue (shape));
-
-/************InterPacket Interval*************/
-  double interval = 0.0;
-  double alpha = 0.2463;
-  double beta = (1/60.227);
-  Ptr<GammaRandomVariable> gRv = CreateObject<GammaRandomVariable> ();
-  gRv->SetAttribute ("Alpha", DoubleValue (alpha));
-  gRv->SetAttribute ("Beta", DoubleValue (beta));
-  interval = gRv->GetValue() + 0.035;       // 0.035s interval corresponds to ~ 30fps
-  //NS_LOG_UNCOND("Inter Packet Interval : " << interval << " ms");
-
-  std::vector<Ptr<Socket>>::size_type rit = staIndex;
-  
-  if(rit < videoRecvSockPtr.size()) { 
-      if(videoPktStats[rit].currentPktCount < videoPktStats[rit].maxPktCount) {
-           pktSize = (uint32_t)(wRv->GetValue());
-           if(videoPktStats[rit].pktSent == 0 || pktSize < 150)
-             pktSize = 150;
-           if(pktSize == 500)
-             pktSize++;
-           pktInterval = Seconds(interval);
-           
-           //  sendSockPtr[rit]->SetPriority (6);  // Interactive
-
-           Time interFrameInterval = MicroSeconds(400);
-           int32_t frameSize = 0;
-           uint32_t count=1;
-           //NS_LOG_UNCOND("Parent Packet size : " << pktSize << " for Sta : " << staIndex << " Now : " << Now());
-           while(pktSize > 0)
-           {
-             if (pktSize > 500){
-               frameSize = 500;
-             }
-             else {
-               frameSize = pktSize;
-             }
-             Simulator::Schedule (count*interFrameInterval, &GenerateVideoFrameTraffic,
-                                    frameSize, staIndex);
-             pktSize = pktSize - 500;
-             count++;
-           }
-           #if _ENABLE_DEBUG_ 
-           NS_LOG_UNCOND("\n ");
-           NS_LOG_UNCOND("### Enqueuing the packet now : " << Now() << " Packet Count : " << videoPktStats[rit].currentPktCount);
-           #endif
-      } else {
-           videoSendSockPtr[rit]->Close();
-      }
-  }
-
-    if (videoPktStats[rit].pktSent == 1){
-       Simulator::Schedule (pktInterval+Seconds(1.0), &GenerateVideoTraffic, 
-                        pktInterval, staIndex, videoClass);
-    }
-    else {
-       Simulator::Schedule (pktInterval, &GenerateVideoTraffic, 
-                       pktInterval, staIndex, videoClass);
-    }
-}
-
 static void
 RxDrop (uint32_t index, Ptr<const Packet> p)
 {
@@ -746,14 +307,17 @@ SetupPacketReceive (Ptr<Node> node, int port, Callback<void, Ptr<Socket> > recvF
   return sink;
 }
 
-Ptr<Socket>
-SetupPacketSend (Ptr<Node> node, Ipv4Address addr, int port)
+Ptr<HeTrafficSource>
+SetupTrafficSource (Ptr<Node> node, Ipv4Address addr, int port, Ptr<HeTrafficModel> model, uint8_t tos)
 {
-  TypeId tid = TypeId::LookupByName ("ns3::UdpSocketFactory");
-  Ptr<Socket> source = Socket::CreateSocket (node, tid);
-  InetSocketAddress remote = InetSocketAddress (addr, port);
-  source->SetAllowBroadcast (true);
-  source->Connect (remote);
+  Ptr<HeTrafficSource> source = CreateObject<HeTrafficSource> ();
+  source->SetAttribute ("Remote", AddressValue (InetSocketAddress (addr, port)));
+  source->SetAttribute ("Model", PointerValue (model));
+  source->SetAttribute ("Tos", UintegerValue (tos));
+  source->SetAttribute ("MaxPackets", UintegerValue (numPackets));
+  // The second frame of every flow is sent 1 s after the first one
+  source->SetAttribute ("WarmUpDelay", TimeValue (Seconds (1.0)));
+  node->AddApplication (source);
   return source;
 }
 
@@ -762,16 +326,19 @@ int main (int argc, char *argv[])
   std::string phyMode ("HeMcs0");
   bool verbose = false;
   NetDeviceContainer devices;
-  pktStats_t  addPktStats = { 0 };
+  pktStats_t  addPktStats = pktStats_t ();
   double base = 1000000.0;
   double throughput = 0.0;
-  uint32_t latency_percentile = 0, jitter_percentile = 0, delayJitterCounter = 0, delayLatencyCounter = 0;
-  uint32_t latency_99_percentile = 0, jitter_99_percentile = 0;
+  uint64_t latency_percentile = 0, jitter_percentile = 0;
+  uint32_t delayJitterCounter = 0, delayLatencyCounter = 0;
+  uint64_t latency_99_percentile = 0, jitter_99_percentile = 0;
   uint32_t nNearStasVo = 0, nNormalStasVo = 0, nEdgeStasVo = 0;
   uint32_t nNearStasVi = 0, nNormalStasVi = 0, nEdgeStasVi = 0;
   uint32_t nNearStasFb = 0, nNormalStasFb = 0, nEdgeStasFb = 0;
   uint32_t runNumber=0;
   double  aggregateThroughput = 0.0;
+  std::string scheduler = "";
+  uint32_t lookahead = 1;
 
   CommandLine cmd;
 
@@ -779,6 +346,11 @@ int main (int argc, char *argv[])
   cmd.AddValue ("voipInterval", "interval (seconds) between packets", voipInterval);
   cmd.AddValue ("verbose", "turn on all WifiNetDevice log components", verbose);
   cmd.AddValue ("runNumber", "the index of the run when running from python script", runNumber);
+  cmd.AddValue ("scheduler", "TypeId of the in-process AP scheduler, e.g. ns3::HePfScheduler; the sample schedulers when empty", scheduler);
+  cmd.AddValue ("lookahead", "Number of TXOPs planned at once by the in-process AP scheduler", lookahead);
+  cmd.AddValue ("saturated", "keep the full buffer flows at a fixed backlog, refilled as they are received, instead of sending a packet every dataInterval", saturated);
+  cmd.AddValue ("videoBurst", "send the fragments of each video frame at once instead of 400 us apart", videoBurst);
+  cmd.AddValue ("rawStats", "keep every latency and jitter sample and dump them to the histfile*.txt files", rawStats);
 
   Config::SetDefault ("ns3::WifiNetDevice::Mtu", UintegerValue (800));
 
@@ -797,7 +369,11 @@ int main (int argc, char *argv[])
   Config::SetDefault ("ns3::WifiRemoteStationManager::NonUnicastMode", 
                       StringValue (phyMode));
   Config::SetDefault ("ns3::RRMWifiManager::SchedulerPlugin",
-                      BooleanValue (false));
+                      BooleanValue (!scheduler.empty ()));
+  Config::SetDefault ("ns3::RRMWifiManager::SchedulerPluginType",
+                      StringValue (scheduler));
+  Config::SetDefault ("ns3::RRMWifiManager::LookaheadTxops",
+                      UintegerValue (lookahead));
   NodeContainer NodeC;
   WifiHelper wifi;
   if (verbose)
@@ -820,8 +396,10 @@ int main (int argc, char *argv[])
   // The below FixedRssLossModel will cause the rss to be fixed regardless
   // of the distance between the two stations, and the transmit power
   //wifiChannel.AddPropagationLoss ("ns3::FixedRssLossModel","Rss",DoubleValue (rss));
-  wifiChannel.AddPropagationLoss ("ns3::Enterprise11axPropagationLossModel");
-  wifiPhy.SetChannel (wifiChannel.Create ());
+  wifiChannel.AddPropagationLoss ("ns3::Enterprise11axPropagationLossModel",
+                                 "CacheLinkLoss", BooleanValue (true));
+  Ptr<HEWifiChannel> channel = wifiChannel.Create ();
+  wifiPhy.SetChannel (channel);
   //wifiPhy.Set ("ChannelNumber", UintegerValue(42));
 
   // Add a mac and disable rate control
@@ -877,12 +455,11 @@ int main (int argc, char *argv[])
       devices.Add (staDevice);
       positionAlloc->Add (Vector (X, Y, Z));
 
-      memset(&addPktStats, '\0', sizeof(addPktStats));
+      addPktStats = pktStats_t ();
       addPktStats.aggDistance = std::sqrt(std::pow((apX-X),2)+std::pow((apY-Y),2)+std::pow((apZ-Z),2));   //distance from AP to STA
       addPktStats.coordinates.push_back(X);
       addPktStats.coordinates.push_back(Y);
       addPktStats.coordinates.push_back(Z);
-      addPktStats.maxPktCount = numPackets;
 
       addPktStats.dropPer = 0;
       if (trafficClass == "AC_VO")
@@ -907,6 +484,13 @@ int main (int argc, char *argv[])
   mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
   mobility.Install (NodeC);
 
+  // Fixed random streams, so that the draws of a run do not depend on the
+  // number of random variables created before them
+  int64_t stream = 1;
+  stream += wifi.AssignStreams (devices, stream);
+  stream += wifiChannel.AssignStreams (channel, stream);
+  initStaTimeRandom->SetStream (stream++);
+
   InternetStackHelper internet;
   internet.Install (NodeC);
 
@@ -917,25 +501,36 @@ int main (int argc, char *argv[])
 
   TypeId tid = TypeId::LookupByName ("ns3::UdpSocketFactory");
   Ptr<Socket> recvSink;
-  Ptr<Socket> source;
+  Ptr<HeTrafficSource> source;
+  double randomStaTime = initStaTimeRandom->GetValue(simulatorBeginRangeStart, simulatorBeginRangeEnd);
+  uint8_t videoClass = 2;   /* Video class */
 
   for(uint32_t i = 0; i < nVoipStas; i ++) {
       uint32_t port, staId;
 
       port = 4000 + i;
       staId = i + 1;
+      Ptr<HeVoipTrafficModel> voipModel = CreateObject<HeVoipTrafficModel> ();
+      voipModel->SetAttribute ("PacketSize", UintegerValue (voipPacketSize));
+      voipModel->SetAttribute ("TalkInterval", TimeValue (interPacketInterval));
 
       if(downlink == true) {    
 	  // Downlink
-	  recvSink = SetupPacketReceive(NodeC.Get (staId), port, MakeCallback (&ReceivePacket));
-	  source = SetupPacketSend(NodeC.Get (0), ipIndex.GetAddress(staId), port);
+	  recvSink = SetupPacketReceive(NodeC.Get (staId), port, MakeBoundCallback (&ReceiveFlowPacket, &pktStats, i));
+	  source = SetupTrafficSource(NodeC.Get (0), ipIndex.GetAddress(staId), port, voipModel, 192);  // AF11
       } else {
           // Uplink
-	  recvSink = SetupPacketReceive(NodeC.Get (0), port, MakeCallback (&ReceivePacket));
-	  source = SetupPacketSend(NodeC.Get (staId), ipIndex.GetAddress(0), port);
+	  recvSink = SetupPacketReceive(NodeC.Get (0), port, MakeBoundCallback (&ReceiveFlowPacket, &pktStats, i));
+	  source = SetupTrafficSource(NodeC.Get (staId), ipIndex.GetAddress(0), port, voipModel, 192);  // AF11
       }
       recvSockPtr.push_back(recvSink);
-      sendSockPtr.push_back(source);
+      pktStats[i].typeOfClientTraffic = CLIENT_TRAFFIC_TYPE_VOICE;
+      pktStats[i].startTime = randomStaTime + 1.0;
+      pktStats[i].source = source;
+      source->TraceConnectWithoutContext ("Tx", MakeBoundCallback (&FlowPacketSent, &pktStats, i));
+      source->SetStartTime (Seconds (randomStaTime));
+      source->SetStopTime (Seconds (simulatorDuration));
+      stream += source->AssignStreams (stream);
   }
 
   for(uint32_t i = nVoipStas + 1; i <= nDataStas + nVoipStas; i ++) {
@@ -943,18 +538,28 @@ int main (int argc, char *argv[])
 
       port = 5000 + i;
       staId = i;
+      Ptr<HeFullBufferTrafficModel> dataModel = CreateObject<HeFullBufferTrafficModel> ();
+      dataModel->SetAttribute ("PacketSize", UintegerValue (dataPacketSize));
+      dataModel->SetAttribute ("Interval", TimeValue (dataPacketInterval));
 
       if(downlink == true) {    
 	  // Downlink
-	  recvSink = SetupPacketReceive(NodeC.Get (staId), port, MakeCallback (&DataReceivePacket));
-	  source = SetupPacketSend(NodeC.Get (0), ipIndex.GetAddress(staId), port);
+	  recvSink = SetupPacketReceive(NodeC.Get (staId), port, MakeBoundCallback (&ReceiveFlowPacket, &dataPktStats, i - nVoipStas - 1));
+	  source = SetupTrafficSource(NodeC.Get (0), ipIndex.GetAddress(staId), port, dataModel, 0);
       } else {
           // Uplink
-	  recvSink = SetupPacketReceive(NodeC.Get (0), port, MakeCallback (&DataReceivePacket));
-	  source = SetupPacketSend(NodeC.Get (staId), ipIndex.GetAddress(0), port);
+	  recvSink = SetupPacketReceive(NodeC.Get (0), port, MakeBoundCallback (&ReceiveFlowPacket, &dataPktStats, i - nVoipStas - 1));
+	  source = SetupTrafficSource(NodeC.Get (staId), ipIndex.GetAddress(0), port, dataModel, 0);
       }
       dataRecvSockPtr.push_back(recvSink);
-      dataSendSockPtr.push_back(source);
+      dataPktStats[i - nVoipStas - 1].typeOfClientTraffic = CLIENT_TRAFFIC_TYPE_BESTEFFORT;
+      dataPktStats[i - nVoipStas - 1].startTime = randomStaTime + 1.0;
+      dataPktStats[i - nVoipStas - 1].source = source;
+      source->SetAttribute ("Saturated", BooleanValue (saturated));
+      source->TraceConnectWithoutContext ("Tx", MakeBoundCallback (&FlowPacketSent, &dataPktStats, i - nVoipStas - 1));
+      source->SetStartTime (Seconds (randomStaTime));
+      source->SetStopTime (Seconds (simulatorDuration));
+      stream += source->AssignStreams (stream);
   }
 
   for(uint32_t i = nDataStas + nVoipStas + 1; i <= nVideoStas + nDataStas + nVoipStas; i ++) {
@@ -962,17 +567,29 @@ int main (int argc, char *argv[])
 
       port = 6000 + i;
       staId = i;
+      Ptr<HeVideoTrafficModel> videoModel = CreateObject<HeVideoTrafficModel> ();
+      videoModel->SetAttribute ("VideoClass", UintegerValue (videoClass));
+      videoModel->SetAttribute ("MinFrameInterval", TimeValue (videoPacketInterval));
       if(downlink == true) {
 	  // Downlink
-	  recvSink = SetupPacketReceive(NodeC.Get (staId), port, MakeCallback (&VideoReceivePacket));
-	  source = SetupPacketSend(NodeC.Get (0), ipIndex.GetAddress(staId), port);
+	  recvSink = SetupPacketReceive(NodeC.Get (staId), port, MakeBoundCallback (&ReceiveFlowPacket, &videoPktStats, i - nDataStas - nVoipStas - 1));
+	  source = SetupTrafficSource(NodeC.Get (0), ipIndex.GetAddress(staId), port, videoModel, 136);  // AF41
       } else {
           // Uplink
-	  recvSink = SetupPacketReceive(NodeC.Get (0), port, MakeCallback (&VideoReceivePacket));
-	  source = SetupPacketSend(NodeC.Get (staId), ipIndex.GetAddress(0), port);
+	  recvSink = SetupPacketReceive(NodeC.Get (0), port, MakeBoundCallback (&ReceiveFlowPacket, &videoPktStats, i - nDataStas - nVoipStas - 1));
+	  source = SetupTrafficSource(NodeC.Get (staId), ipIndex.GetAddress(0), port, videoModel, 136);  // AF41
       }
       videoRecvSockPtr.push_back(recvSink);
-      videoSendSockPtr.push_back(source);
+      videoPktStats[i - nDataStas - nVoipStas - 1].typeOfClientTraffic = CLIENT_TRAFFIC_TYPE_VIDEO;
+      videoPktStats[i - nDataStas - nVoipStas - 1].startTime = randomStaTime + 1.0;
+      videoPktStats[i - nDataStas - nVoipStas - 1].source = source;
+      if(videoBurst) {
+          source->SetAttribute ("FragmentInterval", TimeValue (Seconds (0)));
+      }
+      source->TraceConnectWithoutContext ("Tx", MakeBoundCallback (&FlowPacketSent, &videoPktStats, i - nDataStas - nVoipStas - 1));
+      source->SetStartTime (Seconds (randomStaTime));
+      source->SetStopTime (Seconds (simulatorDuration));
+      stream += source->AssignStreams (stream);
   }
 
   std::ofstream resultsLog;
@@ -991,29 +608,6 @@ int main (int argc, char *argv[])
   //apDevice.Get(0)->GetObject<WifiNetDevice>()->GetRemoteStationManager()->GetObject<RRMWifiManager>()->SetAlgoSubDownlink(subDlScheduler);
   //apDevice.Get(0)->GetObject<WifiNetDevice>()->GetRemoteStationManager()->GetObject<RRMWifiManager>()->SetAlgoUplink(ulScheduler);
 
-  double randomStaTime = initStaTimeRandom->GetValue(simulatorBeginRangeStart, simulatorBeginRangeEnd);
-
-    for(uint32_t staIndex = 0; staIndex < nVoipStas; staIndex ++ ) {
-         pktStats[staIndex].startTime = randomStaTime + 1.0;
-         Simulator::ScheduleWithContext (source->GetNode ()->GetId (),
-                                    Seconds (randomStaTime), &GenerateVoiceTraffic, 
-                                    voipPacketSize, interPacketInterval, staIndex);
-    }
-
-    for(uint32_t staIndex = 0; staIndex < nDataStas; staIndex ++ ) {
-         dataPktStats[staIndex].startTime = randomStaTime + 1.0;
-         Simulator::ScheduleWithContext (source->GetNode ()->GetId (),
-                                    Seconds (randomStaTime), &GenerateDataTraffic, 
-                                    dataPacketSize, dataPacketInterval, staIndex);
-    }
-
-    uint8_t videoClass = 2;   /* Video class */
-    for(uint32_t staIndex = 0; staIndex < nVideoStas; staIndex ++ ) {
-         videoPktStats[staIndex].startTime = randomStaTime + 1.0;
-         Simulator::ScheduleWithContext (source->GetNode ()->GetId (),
-                                    Seconds (randomStaTime), &GenerateVideoTraffic, 
-                                    videoPacketInterval, staIndex, videoClass);
-    }
   Simulator::Schedule (Seconds(1.0), &PrintRunningTime);
 
   for(uint32_t index = 1; index <= nVideoStas + nDataStas + nVoipStas; index ++) {
@@ -1087,8 +681,10 @@ int main (int argc, char *argv[])
 
   std::ofstream histfile_latency;
   std::ofstream histfile_jitter;
-  histfile_latency.open ("histfileLatencyVoip.txt");
-  histfile_jitter.open ("histfileJitterVoip.txt");
+  if (rawStats) {
+    histfile_latency.open ("histfileLatencyVoip.txt");
+    histfile_jitter.open ("histfileJitterVoip.txt");
+  }
   uint32_t numPktRecvd, numPktDropped;
   for (std::vector<pktStats_t>::size_type rit = 0; rit < pktStats.size(); rit++) {
       for(uint32_t delay_index = 0; delay_index < pktStats[rit].jitterStats.size(); delay_index ++) {
@@ -1097,47 +693,34 @@ int main (int argc, char *argv[])
       for(uint32_t delay_index = 0; delay_index < pktStats[rit].latencyStats.size(); delay_index ++) {
           histfile_latency << pktStats[rit].latencyStats[delay_index]/1000000.0 << ",";
       }
-      std::sort(pktStats[rit].latencyStats.begin(), pktStats[rit].latencyStats.end());
-      std::sort(pktStats[rit].jitterStats.begin(), pktStats[rit].jitterStats.end());
 
       double worst_lat = 0.0, avg_lat = 0.0;
       double lat97Per = 0.0, lat99Per = 0.0;
       double worst_jit = 0.0, avg_jit = 0.0;
       double jit97Per = 0.0, jit99Per = 0.0;
       delayJitterCounter = 0;
-      for(uint32_t delay_index = 0; delay_index < pktStats[rit].jitterStats.size(); delay_index ++) {
-          // Number of packets less than 10ms
-          if(pktStats[rit].jitterStats[delay_index] < 10000000) {
-              delayJitterCounter ++;
-          }
-      }
+      // Number of packets less than 10ms
+      delayJitterCounter = pktStats[rit].jitterHist.GetCountBelow(10000000);
       if(delayJitterCounter) {
-          delayJitterCounter = (100 * delayJitterCounter) / pktStats[rit].jitterStats.size();
+          delayJitterCounter = (100 * delayJitterCounter) / pktStats[rit].jitterHist.GetCount();
       }
 
       delayLatencyCounter = 0;
-      for(uint32_t delay_index = 0; delay_index < pktStats[rit].latencyStats.size(); delay_index ++) {
-          // Number of packets less than 60ms
-          if(pktStats[rit].latencyStats[delay_index] < 60000000) {
-              delayLatencyCounter ++;
-          }
-      }
+      // Number of packets less than 60ms
+      delayLatencyCounter = pktStats[rit].latencyHist.GetCountBelow(60000000);
       if(delayLatencyCounter) {
-          delayLatencyCounter = (100 * delayLatencyCounter) / pktStats[rit].latencyStats.size();
+          delayLatencyCounter = (100 * delayLatencyCounter) / pktStats[rit].latencyHist.GetCount();
       }
 
       //Find the 97th percentile
-      latency_percentile = (pktStats[rit].latencyStats.size() * 97) / 100;
-      jitter_percentile = (pktStats[rit].jitterStats.size() * 97) / 100;
+      latency_percentile = pktStats[rit].latencyHist.GetPercentile(97);
+      jitter_percentile = pktStats[rit].jitterHist.GetPercentile(97);
       //Find the 99th percentile
-      latency_99_percentile = (pktStats[rit].latencyStats.size() * 99) / 100;
-      jitter_99_percentile = (pktStats[rit].jitterStats.size() * 99) / 100;
+      latency_99_percentile = pktStats[rit].latencyHist.GetPercentile(99);
+      jitter_99_percentile = pktStats[rit].jitterHist.GetPercentile(99);
 
 #if _ENABLE_DEBUG_ 
-      NS_LOG_UNCOND("### jitter_percentile : " << jitter_percentile << " value : " << pktStats[rit].jitterStats[jitter_percentile - 1]);
-      for(uint32_t print_index = 0; print_index < pktStats[rit].jitterStats.size(); print_index ++) {
-          NS_LOG_UNCOND("### latency : " << pktStats[rit].jitterStats[print_index]);
-      }
+      NS_LOG_UNCOND("### jitter_percentile value : " << jitter_percentile << " over " << pktStats[rit].jitterHist.GetCount() << " samples");
 #endif
 
       if (pktStats[rit].pktSent <= pktStats[rit].pktRecv)
@@ -1153,15 +736,15 @@ int main (int argc, char *argv[])
           " best latency : " << (pktStats[rit].bestLatency/base));
       worst_lat = pktStats[rit].worstLatency/base;
       avg_lat = pktStats[rit].avgLatency/base;
-      if(latency_percentile && pktStats[rit].latencyStats[latency_percentile - 1]) {
-          NS_LOG_UNCOND("      Latency (ms) : " << " 97th percentile latency : " << pktStats[rit].latencyStats[latency_percentile - 1] / base);
-          lat97Per = pktStats[rit].latencyStats[latency_percentile - 1] / base ;
+      if(latency_percentile) {
+          NS_LOG_UNCOND("      Latency (ms) : " << " 97th percentile latency : " << latency_percentile / base);
+          lat97Per = latency_percentile / base ;
       } else {
           NS_LOG_UNCOND("      Latency (ms) : " << " 97th percentile latency : " << 0); 
       }
-      if(latency_99_percentile && pktStats[rit].latencyStats[latency_99_percentile - 1]) {
-          NS_LOG_UNCOND("      Latency (ms) : " << " 99th percentile latency : " << pktStats[rit].latencyStats[latency_99_percentile - 1] / base);
-          lat99Per = pktStats[rit].latencyStats[latency_percentile - 1] / base ;
+      if(latency_99_percentile) {
+          NS_LOG_UNCOND("      Latency (ms) : " << " 99th percentile latency : " << latency_99_percentile / base);
+          lat99Per = latency_99_percentile / base ;
       } else {
           NS_LOG_UNCOND("      Latency (ms) : " << " 99th percentile latency : " << 0); 
       }
@@ -1171,17 +754,17 @@ int main (int argc, char *argv[])
       throughput = (pktStats[rit].pktRecv * voipPacketSize * 8) / (simulatorDuration - pktStats[rit].startTime);
       throughput = throughput / 1000;
       if(pktStats[rit].pktRecv > 2) {
-       if(pktStats[rit].worstJitter && pktStats[rit].avgJitter && pktStats[rit].jitterStats[jitter_percentile - 1]) {
+       if(pktStats[rit].worstJitter && pktStats[rit].avgJitter && jitter_percentile) {
           NS_LOG_UNCOND("      Worst Jitter (milli sec) : " << pktStats[rit].worstJitter / base << " Avg Jitter (milli sec) : " << pktStats[rit].avgJitter / base << \
-                           ", 97th percentile jitter : " << pktStats[rit].jitterStats[jitter_percentile - 1] / base);
+                           ", 97th percentile jitter : " << jitter_percentile / base);
           worst_jit = pktStats[rit].worstJitter / base;
           avg_jit = pktStats[rit].avgJitter / base;
-          jit97Per = pktStats[rit].jitterStats[jitter_percentile - 1] / base;
+          jit97Per = jitter_percentile / base;
        }
       }
-      if(jitter_99_percentile && pktStats[rit].jitterStats[jitter_99_percentile - 1]) {
-         NS_LOG_UNCOND("      99th percentile jitter : " << pktStats[rit].jitterStats[jitter_99_percentile - 1] / base);
-         jit99Per = pktStats[rit].jitterStats[jitter_99_percentile - 1] / base;
+      if(jitter_99_percentile) {
+         NS_LOG_UNCOND("      99th percentile jitter : " << jitter_99_percentile / base);
+         jit99Per = jitter_99_percentile / base;
       }
       throughput_voip << throughput << ",";
       drop_voip << numPktRecvd << "," << numPktDropped << ",";
@@ -1219,8 +802,10 @@ int main (int argc, char *argv[])
 
   NS_LOG_UNCOND("\n---------------------------------------------------------- Data  Client STATS (full buffer)--------------------------------------  ");
 
-  histfile_latency.open ("histfileLatencyFullBuffer.txt");
-  histfile_jitter.open ("histfileJitterFullBuffer.txt");
+  if (rawStats) {
+    histfile_latency.open ("histfileLatencyFullBuffer.txt");
+    histfile_jitter.open ("histfileJitterFullBuffer.txt");
+  }
   for (std::vector<pktStats_t>::size_type rit = 0; rit < dataPktStats.size(); rit++) {
       for(uint32_t delay_index = 0; delay_index < dataPktStats[rit].jitterStats.size(); delay_index ++) {
           histfile_jitter << dataPktStats[rit].jitterStats[delay_index]/1000000.0 << ",";
@@ -1228,47 +813,34 @@ int main (int argc, char *argv[])
       for(uint32_t delay_index = 0; delay_index < dataPktStats[rit].latencyStats.size(); delay_index ++) {
           histfile_latency << dataPktStats[rit].latencyStats[delay_index]/1000000.0 << ",";
       }
-      std::sort(dataPktStats[rit].latencyStats.begin(), dataPktStats[rit].latencyStats.end());
-      std::sort(dataPktStats[rit].jitterStats.begin(), dataPktStats[rit].jitterStats.end());
 
       double worst_lat = 0, avg_lat = 0;
       double lat97Per = 0, lat99Per = 0;
       double worst_jit = 0, avg_jit = 0;
       double jit97Per = 0, jit99Per = 0;
       delayJitterCounter = 0;
-      for(uint32_t delay_index = 0; delay_index < dataPktStats[rit].jitterStats.size(); delay_index ++) {
-          // Number of packets less than 10ms
-          if(dataPktStats[rit].jitterStats[delay_index] < 10000000) {
-              delayJitterCounter ++;
-          }
-      }
+      // Number of packets less than 10ms
+      delayJitterCounter = dataPktStats[rit].jitterHist.GetCountBelow(10000000);
       if(delayJitterCounter) {
-          delayJitterCounter = (100 * delayJitterCounter) / dataPktStats[rit].jitterStats.size();
+          delayJitterCounter = (100 * delayJitterCounter) / dataPktStats[rit].jitterHist.GetCount();
       }
 
       delayLatencyCounter = 0;
-      for(uint32_t delay_index = 0; delay_index < dataPktStats[rit].latencyStats.size(); delay_index ++) {
-          // Number of packets less than 60ms
-          if(dataPktStats[rit].latencyStats[delay_index] < 60000000) {
-              delayLatencyCounter ++;
-          }
-      }
+      // Number of packets less than 60ms
+      delayLatencyCounter = dataPktStats[rit].latencyHist.GetCountBelow(60000000);
       if(delayLatencyCounter) {
-          delayLatencyCounter = (100 * delayLatencyCounter) / dataPktStats[rit].latencyStats.size();
+          delayLatencyCounter = (100 * delayLatencyCounter) / dataPktStats[rit].latencyHist.GetCount();
       }
 
       //Find the 97th percentile
-      latency_percentile = (dataPktStats[rit].latencyStats.size() * 97) / 100;
-      jitter_percentile = (dataPktStats[rit].jitterStats.size() * 97) / 100;
+      latency_percentile = dataPktStats[rit].latencyHist.GetPercentile(97);
+      jitter_percentile = dataPktStats[rit].jitterHist.GetPercentile(97);
       //Find the 99th percentile
-      latency_99_percentile = (dataPktStats[rit].latencyStats.size() * 99) / 100;
-      jitter_99_percentile = (dataPktStats[rit].jitterStats.size() * 99) / 100;
+      latency_99_percentile = dataPktStats[rit].latencyHist.GetPercentile(99);
+      jitter_99_percentile = dataPktStats[rit].jitterHist.GetPercentile(99);
 
 #if _ENABLE_DEBUG_ 
-      NS_LOG_UNCOND("### jitter_percentile : " << jitter_percentile << " value : " << dataPktStats[rit].jitterStats[jitter_percentile - 1]);
-      for(uint32_t print_index = 0; print_index < dataPktStats[rit].jitterStats.size(); print_index ++) {
-          NS_LOG_UNCOND("### latency : " << dataPktStats[rit].jitterStats[print_index]);
-      }
+      NS_LOG_UNCOND("### jitter_percentile value : " << jitter_percentile << " over " << dataPktStats[rit].jitterHist.GetCount() << " samples");
 #endif
 
       if (dataPktStats[rit].pktSent <= dataPktStats[rit].pktRecv)
@@ -1283,30 +855,30 @@ int main (int argc, char *argv[])
           " best latency : " << (dataPktStats[rit].bestLatency/base));
       worst_lat = dataPktStats[rit].worstLatency/base;
       avg_lat = dataPktStats[rit].avgLatency/base;
-      if(latency_percentile && dataPktStats[rit].latencyStats[latency_percentile - 1]) {
-          NS_LOG_UNCOND("      Latency (ms) : " << " 97th percentile latency : " << dataPktStats[rit].latencyStats[latency_percentile - 1] / base);
-          lat97Per = dataPktStats[rit].latencyStats[latency_percentile - 1] / base;
+      if(latency_percentile) {
+          NS_LOG_UNCOND("      Latency (ms) : " << " 97th percentile latency : " << latency_percentile / base);
+          lat97Per = latency_percentile / base;
       }
-      if(latency_99_percentile && dataPktStats[rit].latencyStats[latency_99_percentile - 1]) {
-          NS_LOG_UNCOND("      Latency (ms) : " << " 99th percentile latency : " << dataPktStats[rit].latencyStats[latency_99_percentile - 1] / base);
-          lat99Per = dataPktStats[rit].latencyStats[latency_99_percentile - 1] / base;
+      if(latency_99_percentile) {
+          NS_LOG_UNCOND("      Latency (ms) : " << " 99th percentile latency : " << latency_99_percentile / base);
+          lat99Per = latency_99_percentile / base;
       }
 
       throughput = (dataPktStats[rit].pktRecv * dataPacketSize * 8) / (simulatorDuration - dataPktStats[rit].startTime);
       NS_LOG_UNCOND("      Simulator Start Time : " << dataPktStats[rit].startTime << ", Simulator Duration : " << simulatorDuration);
       throughput = throughput / 1000;
       if(dataPktStats[rit].pktRecv > 2) {
-       if(dataPktStats[rit].worstJitter && dataPktStats[rit].avgJitter && dataPktStats[rit].jitterStats[jitter_percentile - 1]) {
+       if(dataPktStats[rit].worstJitter && dataPktStats[rit].avgJitter && jitter_percentile) {
           NS_LOG_UNCOND("      Worst Jitter (milli sec) : " << dataPktStats[rit].worstJitter / base << " Avg Jitter (milli sec) : " << dataPktStats[rit].avgJitter / base << \
-                           " 97th percentile jitter : " << dataPktStats[rit].jitterStats[jitter_percentile - 1] / base);
+                           " 97th percentile jitter : " << jitter_percentile / base);
           worst_jit = dataPktStats[rit].worstJitter / base;
           avg_jit = dataPktStats[rit].avgJitter / base;
-          jit97Per = dataPktStats[rit].jitterStats[jitter_percentile - 1] / base;
+          jit97Per = jitter_percentile / base;
        }
       }
-      if(jitter_99_percentile && dataPktStats[rit].jitterStats[jitter_99_percentile - 1]) {
-      NS_LOG_UNCOND("      99th percentile jitter : " << dataPktStats[rit].jitterStats[jitter_99_percentile - 1] / base);
-        jit99Per = dataPktStats[rit].jitterStats[jitter_99_percentile - 1] / base;
+      if(jitter_99_percentile) {
+      NS_LOG_UNCOND("      99th percentile jitter : " << jitter_99_percentile / base);
+        jit99Per = jitter_99_percentile / base;
       }
       throughput_fullBuffer << throughput/1000 << ",";
       drop_fullBuffer << numPktRecvd << "," << numPktDropped << ",";
@@ -1340,8 +912,10 @@ int main (int argc, char *argv[])
 
   NS_LOG_UNCOND("\n---------------------------------------------------------- Video  Client STATS -------------------------------------------------  ");
 
-  histfile_latency.open ("histfileLatencyVideo.txt");
-  histfile_jitter.open ("histfileJitterVideo.txt");
+  if (rawStats) {
+    histfile_latency.open ("histfileLatencyVideo.txt");
+    histfile_jitter.open ("histfileJitterVideo.txt");
+  }
   for (std::vector<pktStats_t>::size_type rit = 0; rit < videoPktStats.size(); rit++) {
       for(uint32_t delay_index = 0; delay_index < videoPktStats[rit].jitterStats.size(); delay_index ++) {
           histfile_jitter << videoPktStats[rit].jitterStats[delay_index]/1000000.0 << ",";
@@ -1349,47 +923,34 @@ int main (int argc, char *argv[])
       for(uint32_t delay_index = 0; delay_index < videoPktStats[rit].latencyStats.size(); delay_index ++) {
           histfile_latency << videoPktStats[rit].latencyStats[delay_index]/1000000.0 << ",";
       }
-      std::sort(videoPktStats[rit].latencyStats.begin(), videoPktStats[rit].latencyStats.end());
-      std::sort(videoPktStats[rit].jitterStats.begin(), videoPktStats[rit].jitterStats.end());
 
       double worst_lat = 0, avg_lat = 0;
       double lat97Per = 0, lat99Per = 0;
       double worst_jit = 0, avg_jit = 0;
       double jit97Per = 0, jit99Per = 0;
       delayJitterCounter = 0;
-      for(uint32_t delay_index = 0; delay_index < videoPktStats[rit].jitterStats.size(); delay_index ++) {
-          // Number of packets less than 10ms
-          if(videoPktStats[rit].jitterStats[delay_index] < 10000000) {
-              delayJitterCounter ++;
-          }
-      }
+      // Number of packets less than 10ms
+      delayJitterCounter = videoPktStats[rit].jitterHist.GetCountBelow(10000000);
       if(delayJitterCounter) {
-          delayJitterCounter = (100 * delayJitterCounter) / videoPktStats[rit].jitterStats.size();
+          delayJitterCounter = (100 * delayJitterCounter) / videoPktStats[rit].jitterHist.GetCount();
       }
 
       delayLatencyCounter = 0;
-      for(uint32_t delay_index = 0; delay_index < videoPktStats[rit].latencyStats.size(); delay_index ++) {
-          // Number of packets less than 60ms
-          if(videoPktStats[rit].latencyStats[delay_index] < 60000000) {
-              delayLatencyCounter ++;
-          }
-      }
+      // Number of packets less than 60ms
+      delayLatencyCounter = videoPktStats[rit].latencyHist.GetCountBelow(60000000);
       if(delayLatencyCounter) {
-          delayLatencyCounter = (100 * delayLatencyCounter) / videoPktStats[rit].latencyStats.size();
+          delayLatencyCounter = (100 * delayLatencyCounter) / videoPktStats[rit].latencyHist.GetCount();
       }
 
       //Find the 97th percentile
-      latency_percentile = (videoPktStats[rit].latencyStats.size() * 97) / 100;
-      jitter_percentile = (videoPktStats[rit].jitterStats.size() * 97) / 100;
+      latency_percentile = videoPktStats[rit].latencyHist.GetPercentile(97);
+      jitter_percentile = videoPktStats[rit].jitterHist.GetPercentile(97);
       //Find the 99th percentile
-      latency_99_percentile = (videoPktStats[rit].latencyStats.size() * 99) / 100;
-      jitter_99_percentile = (videoPktStats[rit].jitterStats.size() * 99) / 100;
+      latency_99_percentile = videoPktStats[rit].latencyHist.GetPercentile(99);
+      jitter_99_percentile = videoPktStats[rit].jitterHist.GetPercentile(99);
 
 #if _ENABLE_DEBUG_ 
-      NS_LOG_UNCOND("### jitter_percentile : " << jitter_percentile << " value : " << videoPktStats[rit].jitterStats[jitter_percentile - 1]);
-      for(uint32_t print_index = 0; print_index < videoPktStats[rit].jitterStats.size(); print_index ++) {
-          NS_LOG_UNCOND("### latency : " << videoPktStats[rit].jitterStats[print_index]);
-      }
+      NS_LOG_UNCOND("### jitter_percentile value : " << jitter_percentile << " over " << videoPktStats[rit].jitterHist.GetCount() << " samples");
 #endif
 
       if (videoPktStats[rit].pktSent <= videoPktStats[rit].pktRecv)
@@ -1404,13 +965,13 @@ int main (int argc, char *argv[])
           " best latency : " << (videoPktStats[rit].bestLatency/base));
       worst_lat = videoPktStats[rit].worstLatency/base;
       avg_lat = videoPktStats[rit].avgLatency/base;
-      if(latency_percentile && videoPktStats[rit].latencyStats[latency_percentile - 1]) {
-          NS_LOG_UNCOND("      Latency (ms) : " << " 97th percentile latency : " << videoPktStats[rit].latencyStats[latency_percentile - 1] / base);
-          lat97Per = videoPktStats[rit].latencyStats[latency_percentile - 1] / base;
+      if(latency_percentile) {
+          NS_LOG_UNCOND("      Latency (ms) : " << " 97th percentile latency : " << latency_percentile / base);
+          lat97Per = latency_percentile / base;
       }
-      if(latency_99_percentile && videoPktStats[rit].latencyStats[latency_99_percentile - 1]) {
-          NS_LOG_UNCOND("      Latency (ms) : " << " 99th percentile latency : " << videoPktStats[rit].latencyStats[latency_99_percentile - 1] / base);
-          lat99Per = videoPktStats[rit].latencyStats[latency_99_percentile - 1] / base;
+      if(latency_99_percentile) {
+          NS_LOG_UNCOND("      Latency (ms) : " << " 99th percentile latency : " << latency_99_percentile / base);
+          lat99Per = latency_99_percentile / base;
       }
 
       throughput = (videoPktStats[rit].pktRecv * videoPktStats[rit].avgPktSize * 8) / (simulatorDuration - videoPktStats[rit].startTime);
@@ -1418,17 +979,17 @@ int main (int argc, char *argv[])
       throughput = throughput / 1000;
 
       if(videoPktStats[rit].pktRecv > 2) {
-        if(videoPktStats[rit].worstJitter && videoPktStats[rit].avgJitter && videoPktStats[rit].jitterStats[jitter_percentile - 1]) {
+        if(videoPktStats[rit].worstJitter && videoPktStats[rit].avgJitter && jitter_percentile) {
           NS_LOG_UNCOND("      Worst Jitter (milli sec) : " << videoPktStats[rit].worstJitter / base << " Avg Jitter (milli sec) : " << videoPktStats[rit].avgJitter / base << \
-                           " 97th percentile jitter : " << videoPktStats[rit].jitterStats[jitter_percentile - 1] / base);
+                           " 97th percentile jitter : " << jitter_percentile / base);
           worst_jit = videoPktStats[rit].worstJitter / base;
           avg_jit = videoPktStats[rit].avgJitter / base;
-          jit97Per = videoPktStats[rit].jitterStats[jitter_percentile - 1] / base;
+          jit97Per = jitter_percentile / base;
         }
       }
-      if(jitter_99_percentile && videoPktStats[rit].jitterStats[jitter_99_percentile - 1]) {
-      NS_LOG_UNCOND("      99th percentile jitter : " << videoPktStats[rit].jitterStats[jitter_99_percentile - 1] / base);
-        jit99Per = videoPktStats[rit].jitterStats[jitter_99_percentile - 1]/base;
+      if(jitter_99_percentile) {
+      NS_LOG_UNCOND("      99th percentile jitter : " << jitter_99_percentile / base);
+        jit99Per = jitter_99_percentile/base;
       }
       throughput_video << throughput/1000 << ",";
       drop_video << numPktRecvd << "," << numPktDropped << ",";
@@ -1514,6 +1075,10 @@ int main (int argc, char *argv[])
   NS_LOG_UNCOND(" Total Resource Available : " << totalAxResourceUL << " Used Resource : " << usedAxResourceUL << " Unused Resource : " << totalAxResourceUL-usedAxResourceUL);
   NS_LOG_UNCOND("\n--------------------Throughput--------------------");
   NS_LOG_UNCOND(" Aggegate Throughput in AP : " << aggregateThroughput << " kbps");
+  if (lookahead > 1)
+    {
+      NS_LOG_UNCOND(" Scheduler replan rate : " << apDevice.Get(0)->GetObject<WifiNetDevice>()->GetRemoteStationManager()->GetObject<RRMWifiManager>()->GetReplanRate());
+    }
   NS_LOG_UNCOND("\n--------------------Queue Drop Stats--------------------");
   double afterQueueDrop = 0;
   double beforeQueueDrop = 0;